@@ -0,0 +1,62 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <limits>
+
+/**
+ * Benchmark helpers
+ *
+ * Time the current implementation of a code path against the one it replaced. Each
+ * function runs a number of times and the fastest run is reported, as it is the one
+ * least disturbed by other processes.
+ */
+namespace benchmark {
+
+/** Number of times each function is timed */
+constexpr int REPETITIONS = 5;
+
+/**
+ * Get the duration of the fastest of REPETITIONS runs of \p function
+ * @param function Function to time
+ * @return Duration in milliseconds
+ */
+template<typename Function>
+double measure(Function&& function)
+{
+    auto fastest = std::numeric_limits<double>::infinity();
+
+    for (int repetition = 0; repetition < REPETITIONS; repetition++) {
+        const auto start = std::chrono::steady_clock::now();
+
+        function();
+
+        const auto end = std::chrono::steady_clock::now();
+
+        fastest = std::min(fastest, std::chrono::duration<double, std::milli>(end - start).count());
+    }
+
+    return fastest;
+}
+
+/** Print the column headers of the report */
+inline void printHeader()
+{
+    std::printf("%-32s %12s %14s %14s %10s\n", "Case", "Size", "Previous", "Current", "Speedup");
+}
+
+/**
+ * Print one row of the report
+ * @param name Name of the case
+ * @param size Size of the input (e.g. number of points)
+ * @param previous Duration of the replaced implementation in milliseconds
+ * @param current Duration of the current implementation in milliseconds
+ */
+inline void printRow(const char* name, std::size_t size, double previous, double current)
+{
+    std::printf("%-32s %12zu %11.3f ms %11.3f ms %9.2fx\n", name, size, previous, current, previous / current);
+}
+
+}
@@ -0,0 +1,68 @@
+#include "Benchmark.h"
+
+#include "PositionBounds.h"
+#include "PositionView.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+    /** Bounds of the widget before the bounds helpers, four scalar updates through the bounds setters per point */
+    Bounds getDataBounds(const std::vector<Vector2f>& points)
+    {
+        Bounds bounds = Bounds::Max;
+
+        for (const Vector2f& point : points)
+        {
+            bounds.setLeft(std::min(point.x, bounds.getLeft()));
+            bounds.setRight(std::max(point.x, bounds.getRight()));
+            bounds.setBottom(std::min(point.y, bounds.getBottom()));
+            bounds.setTop(std::max(point.y, bounds.getTop()));
+        }
+
+        return bounds;
+    }
+
+    /** Returns true when \p first and \p second have the same extent */
+    bool isEqual(const Bounds& first, const Bounds& second)
+    {
+        return first.getLeft() == second.getLeft() && first.getRight() == second.getRight() && first.getBottom() == second.getBottom() && first.getTop() == second.getTop();
+    }
+}
+
+/**
+ * Compares the parallel, vectorized bounds of the finite positions with the previous
+ * scalar bounds computation, for one, ten and fifty million normally distributed
+ * positions (all finite, so that both compute the same bounds).
+ */
+int main(int argc, char* argv[])
+{
+    std::mt19937 generator(1);
+    std::normal_distribution<float> distribution(0.0f, 10.0f);
+
+    benchmark::printHeader();
+
+    for (const std::size_t numberOfPoints : { 1000000, 10000000, 50000000 }) {
+        std::vector<Vector2f> positions(numberOfPoints);
+
+        for (auto& position : positions)
+            position = Vector2f(distribution(generator), distribution(generator));
+
+        Bounds previousBounds, currentBounds;
+
+        const auto previous = benchmark::measure([&]() { previousBounds = getDataBounds(positions); });
+        const auto current  = benchmark::measure([&]() { currentBounds = bounds::getFiniteBounds(PositionView(positions)); });
+
+        benchmark::printRow("Position bounds", numberOfPoints, previous, current);
+
+        if (!isEqual(previousBounds, currentBounds)) {
+            std::printf("The bounds differ\n");
+            return 1;
+        }
+    }
+
+    return 0;
+}
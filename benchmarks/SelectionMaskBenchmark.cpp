@@ -0,0 +1,121 @@
+#include "Benchmark.h"
+
+#include "SelectionMask.h"
+
+#include <QImage>
+#include <QPoint>
+#include <QPointF>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+    /** Build a selection area image of \p width by \p height with a selected disk and rectangle (premultiplied ARGB, as the pixel selection tool draws it) */
+    QImage createSelectionAreaImage(int width, int height)
+    {
+        QImage selectionAreaImage(width, height, QImage::Format_ARGB32_Premultiplied);
+
+        selectionAreaImage.fill(Qt::transparent);
+
+        const auto centerX  = width / 2;
+        const auto centerY  = height / 2;
+        const auto radius   = std::min(width, height) / 3;
+
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                const auto isInDisk         = (x - centerX) * (x - centerX) + (y - centerY) * (y - centerY) <= radius * radius;
+                const auto isInRectangle    = x > width / 8 && x < width / 3 && y > height / 8 && y < height / 4;
+
+                if (isInDisk || isInRectangle)
+                    selectionAreaImage.setPixel(x, y, qRgba(0, 0, 0, 255));
+            }
+        }
+
+        return selectionAreaImage;
+    }
+
+    /** Hit test of the plugin before the selection mask, one bounds checked and format converting lookup per point */
+    std::vector<std::uint32_t> selectByPixelColor(const QImage& selectionAreaImage, const Bounds& dataBounds, const std::vector<Vector2f>& positions)
+    {
+        std::vector<std::uint32_t> targetSelectionIndices;
+
+        targetSelectionIndices.reserve(positions.size());
+
+        const auto width    = selectionAreaImage.width();
+        const auto height   = selectionAreaImage.height();
+        const auto size     = width < height ? width : height;
+
+        for (std::uint32_t i = 0; i < positions.size(); i++) {
+            const auto uvNormalized = QPointF((positions[i].x - dataBounds.getLeft()) / dataBounds.getWidth(), (dataBounds.getTop() - positions[i].y) / dataBounds.getHeight());
+            const auto uvOffset     = QPoint((selectionAreaImage.width() - size) / 2.0f, (selectionAreaImage.height() - size) / 2.0f);
+            const auto uv           = uvOffset + QPoint(uvNormalized.x() * size, uvNormalized.y() * size);
+
+            if (selectionAreaImage.pixelColor(uv).alpha() > 0)
+                targetSelectionIndices.push_back(i);
+        }
+
+        return targetSelectionIndices;
+    }
+
+    /** Hit test through the selection mask, which converts the selection area image once (included in the timing) */
+    std::vector<std::uint32_t> selectBySelectionMask(const QImage& selectionAreaImage, const Bounds& dataBounds, const std::vector<Vector2f>& positions)
+    {
+        std::vector<std::uint32_t> targetSelectionIndices;
+
+        targetSelectionIndices.reserve(positions.size());
+
+        const SelectionMask selectionMask(selectionAreaImage, dataBounds);
+
+        for (std::uint32_t i = 0; i < positions.size(); i++)
+            if (selectionMask.containsPosition(positions[i].x, positions[i].y))
+                targetSelectionIndices.push_back(i);
+
+        return targetSelectionIndices;
+    }
+}
+
+/**
+ * Compares the hit test through the selection mask with the previous per point
+ * QImage::pixelColor() lookup of the selection area image, for one and ten million
+ * points spread uniformly over the data bounds.
+ */
+int main(int argc, char* argv[])
+{
+    const auto selectionAreaImage = createSelectionAreaImage(1600, 1000);
+
+    Bounds dataBounds;
+
+    dataBounds.setLeft(-1.0f);
+    dataBounds.setRight(1.0f);
+    dataBounds.setBottom(-1.0f);
+    dataBounds.setTop(1.0f);
+
+    std::mt19937 generator(1);
+
+    // Keep the points just inside the bounds, the previous lookup selects pixels outside the image
+    std::uniform_real_distribution<float> distribution(-0.999f, 0.999f);
+
+    benchmark::printHeader();
+
+    for (const std::size_t numberOfPoints : { 1000000, 10000000 }) {
+        std::vector<Vector2f> positions(numberOfPoints);
+
+        for (auto& position : positions)
+            position = Vector2f(distribution(generator), distribution(generator));
+
+        std::vector<std::uint32_t> previousIndices, currentIndices;
+
+        const auto previous = benchmark::measure([&]() { previousIndices = selectByPixelColor(selectionAreaImage, dataBounds, positions); });
+        const auto current  = benchmark::measure([&]() { currentIndices = selectBySelectionMask(selectionAreaImage, dataBounds, positions); });
+
+        benchmark::printRow("Selection area hit test", numberOfPoints, previous, current);
+
+        // Single and double precision pixel mapping may round points on a pixel edge differently
+        std::printf("%-32s %12zu %14zu %14zu\n", "  Selected points", numberOfPoints, previousIndices.size(), currentIndices.size());
+    }
+
+    return 0;
+}
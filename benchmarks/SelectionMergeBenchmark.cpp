@@ -0,0 +1,101 @@
+#include "Benchmark.h"
+
+#include "SelectionMerge.h"
+
+#include <QSet>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace {
+
+    /** Selection modifier of the merge */
+    enum class Modifier {
+        Add,        /** Unite the selection with the target indices */
+        Subtract    /** Remove the target indices from the selection */
+    };
+
+    /** Merge of the plugin before the sorted merge, which hashes the complete selection */
+    std::vector<std::uint32_t> mergeByHashing(const std::vector<std::uint32_t>& selectionIndices, const std::vector<std::uint32_t>& targetSelectionIndices, Modifier modifier)
+    {
+        QSet<std::uint32_t> set(selectionIndices.begin(), selectionIndices.end());
+
+        if (modifier == Modifier::Add) {
+            for (const auto& targetIndex : targetSelectionIndices)
+                set.insert(targetIndex);
+        }
+        else {
+            for (const auto& targetIndex : targetSelectionIndices)
+                set.remove(targetIndex);
+        }
+
+        return std::vector<std::uint32_t>(set.begin(), set.end());
+    }
+
+    /** Sorted merge, the target indices arrive in hit test order and are sorted first (included in the timing) */
+    std::vector<std::uint32_t> mergeSorted(const std::vector<std::uint32_t>& selectionIndices, std::vector<std::uint32_t> targetSelectionIndices, Modifier modifier)
+    {
+        selection::makeSorted(targetSelectionIndices);
+
+        if (modifier == Modifier::Add)
+            return selection::unite(selectionIndices, targetSelectionIndices);
+
+        return selection::subtract(selectionIndices, targetSelectionIndices);
+    }
+
+    /** Get \p count distinct random indices below \p range, in random order */
+    std::vector<std::uint32_t> getRandomIndices(std::uint32_t count, std::uint32_t range, std::mt19937& generator)
+    {
+        std::vector<std::uint32_t> indices(range);
+
+        std::iota(indices.begin(), indices.end(), 0u);
+        std::shuffle(indices.begin(), indices.end(), generator);
+
+        indices.resize(count);
+
+        return indices;
+    }
+}
+
+/**
+ * Compares the sorted merge of the selection modifiers with the previous QSet based
+ * merge, for selections of ten thousand, one million and ten million indices which
+ * are merged with as many target indices (about half of which are selected already).
+ */
+int main(int argc, char* argv[])
+{
+    std::mt19937 generator(1);
+
+    benchmark::printHeader();
+
+    for (const std::uint32_t numberOfIndices : { 10000u, 1000000u, 10000000u }) {
+        // The plugin keeps the selection indices sorted
+        auto selectionIndices = getRandomIndices(numberOfIndices, 2 * numberOfIndices, generator);
+
+        std::sort(selectionIndices.begin(), selectionIndices.end());
+
+        const auto targetSelectionIndices = getRandomIndices(numberOfIndices, 2 * numberOfIndices, generator);
+
+        for (const auto modifier : { Modifier::Add, Modifier::Subtract }) {
+            std::vector<std::uint32_t> previousIndices, currentIndices;
+
+            const auto previous = benchmark::measure([&]() { previousIndices = mergeByHashing(selectionIndices, targetSelectionIndices, modifier); });
+            const auto current  = benchmark::measure([&]() { currentIndices = mergeSorted(selectionIndices, targetSelectionIndices, modifier); });
+
+            benchmark::printRow(modifier == Modifier::Add ? "Add to selection" : "Subtract from selection", numberOfIndices, previous, current);
+
+            // The hashed merge returns the indices in arbitrary order
+            std::sort(previousIndices.begin(), previousIndices.end());
+
+            if (previousIndices != currentIndices) {
+                std::printf("The merged selections differ\n");
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
@@ -101,7 +101,7 @@ ClusteringAction::ClusteringAction(QObject* parent, const QString& title) :
 
     const auto updateActionsReadOnly = [this]() -> void {
         const auto positionDataset          = _scatterplotPlugin->getPositionDataset();
-        const auto numberOfSelectedPoints   = positionDataset.isValid() ? positionDataset->getSelectionSize() : 0;
+        const auto numberOfSelectedPoints   = positionDataset.isValid() ? _scatterplotPlugin->getLocalSelection().getNumberOfSelectedPoints() : 0;
         const auto hasSelection             = numberOfSelectedPoints >= 1;
         const auto canAddCluster            = hasSelection && !_nameAction.getString().isEmpty();
         
@@ -115,7 +115,7 @@ ClusteringAction::ClusteringAction(QObject* parent, const QString& title) :
     updateActionsReadOnly();
 
     connect(&_scatterplotPlugin->getPositionDataset(), &Dataset<Points>::changed, this, updateActionsReadOnly);
-    connect(&_scatterplotPlugin->getPositionDataset(), &Dataset<Points>::dataSelectionChanged, this, updateActionsReadOnly);
+    connect(_scatterplotPlugin, &ScatterplotPlugin::localSelectionChanged, this, updateActionsReadOnly);
     connect(&_nameAction, &StringAction::stringChanged, this, updateActionsReadOnly);
     connect(&_clusterDatasetPickerAction, &DatasetPickerAction::datasetPicked, this, updateActionsReadOnly);
 
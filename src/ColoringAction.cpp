@@ -84,7 +84,7 @@ ColoringAction::ColoringAction(QObject* parent, const QString& title) :
             //_dimensionAction.setVisible(false);
         }
 
-        updateScatterPlotWidgetColors();
+        requestScatterPlotWidgetColors();
         updateScatterplotWidgetColorMap();
         updateColorMapActionScalarRange();
         updateColorMapActionsReadOnly();
@@ -93,10 +93,10 @@ ColoringAction::ColoringAction(QObject* parent, const QString& title) :
     connect(&_scatterplotPlugin->getPositionDataset(), &Dataset<Points>::childAdded, this, &ColoringAction::updateColorByActionOptions);
     connect(&_scatterplotPlugin->getPositionDataset(), &Dataset<Points>::childRemoved, this, &ColoringAction::updateColorByActionOptions);
 
-    connect(&_scatterplotPlugin->getScatterplotWidget(), &ScatterplotWidget::renderModeChanged, this, &ColoringAction::updateScatterPlotWidgetColors);
-    connect(&_scatterplotPlugin->getScatterplotWidget(), &ScatterplotWidget::coloringModeChanged, this, &ColoringAction::updateScatterPlotWidgetColors);
+    connect(&_scatterplotPlugin->getScatterplotWidget(), &ScatterplotWidget::renderModeChanged, this, &ColoringAction::requestScatterPlotWidgetColors);
+    connect(&_scatterplotPlugin->getScatterplotWidget(), &ScatterplotWidget::coloringModeChanged, this, &ColoringAction::requestScatterPlotWidgetColors);
 
-    connect(&_dimensionAction, &DimensionPickerAction::currentDimensionIndexChanged, this, &ColoringAction::updateScatterPlotWidgetColors);
+    connect(&_dimensionAction, &DimensionPickerAction::currentDimensionIndexChanged, this, &ColoringAction::requestScatterPlotWidgetColors);
     connect(&_dimensionAction, &DimensionPickerAction::currentDimensionIndexChanged, this, &ColoringAction::updateColorMapActionScalarRange);
     
     connect(&_constantColorAction, &ColorAction::colorChanged, this, &ColoringAction::updateScatterplotWidgetColorMap);
@@ -157,7 +157,7 @@ void ColoringAction::addColorDataset(const Dataset<DatasetImpl>& colorDataset)
                 return;
 
             if (currentColorDataset == dataset)
-                updateScatterPlotWidgetColors();
+                requestScatterPlotWidgetColors();
         });
     }
 }
@@ -207,6 +207,11 @@ void ColoringAction::updateColorByActionOptions()
     }
 }
 
+void ColoringAction::requestScatterPlotWidgetColors()
+{
+    _scatterplotPlugin->requestUpdate(ScatterplotPlugin::Colors);
+}
+
 void ColoringAction::updateScatterPlotWidgetColors()
 {
     if (_colorByAction.getCurrentIndex() <= 1)
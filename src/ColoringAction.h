@@ -66,6 +66,9 @@ protected:
     /** Update the color by action options */
     void updateColorByActionOptions();
 
+    /** Request an update of the colors of the points, coalesced with the other pending scatter plot updates */
+    void requestScatterPlotWidgetColors();
+
     /** Update the colors of the points in the scatter plot widget */
     void updateScatterPlotWidgetColors();
 
@@ -6,6 +6,7 @@ using namespace mv::gui;
 
 DensityPlotAction::DensityPlotAction(QObject* parent, const QString& title) :
     VerticalGroupAction(parent, title),
+    _scatterplotPlugin(nullptr),
     _sigmaAction(this, "Sigma", 0.01f, 0.5f, DEFAULT_SIGMA, 3),
     _continuousUpdatesAction(this, "Live Updates", DEFAULT_CONTINUOUS_UPDATES)
 {
@@ -26,19 +27,7 @@ void DensityPlotAction::initialize(ScatterplotPlugin* scatterplotPlugin)
 
     _scatterplotPlugin = scatterplotPlugin;
 
-    const auto computeDensity = [this]() -> void {
-        if (static_cast<std::int32_t>(_scatterplotPlugin->getSettingsAction().getRenderModeAction().getCurrentIndex()) == ScatterplotWidget::RenderMode::SCATTERPLOT)
-            return;
-
-        _scatterplotPlugin->getScatterplotWidget().setSigma(_sigmaAction.getValue());
-
-        const auto maxDensity = _scatterplotPlugin->getScatterplotWidget().getDensityRenderer().getMaxDensity();
-
-        if (maxDensity > 0)
-            _scatterplotPlugin->getSettingsAction().getColoringAction().getColorMap1DAction().getRangeAction(ColorMapAction::Axis::X).setRange({ 0.0f, maxDensity });
-    };
-
-    connect(&_sigmaAction, &DecimalAction::valueChanged, this, computeDensity);
+    connect(&_sigmaAction, &DecimalAction::valueChanged, this, &DensityPlotAction::updateDensity);
 
     const auto updateSigmaAction = [this]() {
         _sigmaAction.setUpdateDuringDrag(_continuousUpdatesAction.isChecked());
@@ -46,15 +35,33 @@ void DensityPlotAction::initialize(ScatterplotPlugin* scatterplotPlugin)
 
     connect(&_continuousUpdatesAction, &ToggleAction::toggled, updateSigmaAction);
 
-    connect(&_scatterplotPlugin->getPositionDataset(), &Dataset<Points>::changed, this, [this, updateSigmaAction, computeDensity](DatasetImpl* dataset) {
+    connect(&_scatterplotPlugin->getPositionDataset(), &Dataset<Points>::changed, this, [this, updateSigmaAction](DatasetImpl* dataset) {
         updateSigmaAction();
-        computeDensity();
+
+        // The density is updated after the positions of the new dataset are loaded
+        _scatterplotPlugin->requestUpdate(ScatterplotPlugin::Density);
     });
 
-    connect(&_scatterplotPlugin->getSettingsAction().getRenderModeAction(), &OptionAction::currentIndexChanged, this, computeDensity);
+    connect(&_scatterplotPlugin->getSettingsAction().getRenderModeAction(), &OptionAction::currentIndexChanged, this, &DensityPlotAction::updateDensity);
 
     updateSigmaAction();
-    computeDensity();
+    updateDensity();
+}
+
+void DensityPlotAction::updateDensity()
+{
+    if (_scatterplotPlugin == nullptr)
+        return;
+
+    if (static_cast<std::int32_t>(_scatterplotPlugin->getSettingsAction().getRenderModeAction().getCurrentIndex()) == ScatterplotWidget::RenderMode::SCATTERPLOT)
+        return;
+
+    _scatterplotPlugin->getScatterplotWidget().setSigma(_sigmaAction.getValue());
+
+    const auto maxDensity = _scatterplotPlugin->getScatterplotWidget().getDensityRenderer().getMaxDensity();
+
+    if (maxDensity > 0)
+        _scatterplotPlugin->getSettingsAction().getColoringAction().getColorMap1DAction().getRangeAction(ColorMapAction::Axis::X).setRange({ 0.0f, maxDensity });
 }
 
 QMenu* DensityPlotAction::getContextMenu()
@@ -46,6 +46,11 @@ public:
      */
     void setVisible(bool visible);
 
+protected:
+
+    /** Assign the sigma to the scatter plot widget and update the color map range to the maximum density */
+    void updateDensity();
+
 protected: // Linking
 
     /**
@@ -89,6 +94,7 @@ private:
     static constexpr bool DEFAULT_CONTINUOUS_UPDATES = true;
 
     friend class PlotAction;
+    friend class ScatterplotPlugin;
     friend class mv::AbstractActionsManager;
 };
 
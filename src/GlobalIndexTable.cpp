@@ -0,0 +1,45 @@
+#include "GlobalIndexTable.h"
+
+#include <algorithm>
+#include <utility>
+
+GlobalIndexTable::GlobalIndexTable() :
+    _valid(false),
+    _globalIndices(),
+    _localIndices()
+{
+}
+
+void GlobalIndexTable::build(std::vector<std::uint32_t>&& localGlobalIndices)
+{
+    _globalIndices = std::move(localGlobalIndices);
+
+    const auto maximumGlobalIndex = _globalIndices.empty() ? 0 : *std::max_element(_globalIndices.begin(), _globalIndices.end());
+
+    _localIndices.assign(_globalIndices.empty() ? 0 : static_cast<std::size_t>(maximumGlobalIndex) + 1, INVALID_INDEX);
+
+    for (std::uint32_t localIndex = 0; localIndex < _globalIndices.size(); localIndex++)
+        _localIndices[_globalIndices[localIndex]] = localIndex;
+
+    _valid = true;
+}
+
+void GlobalIndexTable::invalidate()
+{
+    _valid = false;
+
+    _globalIndices.clear();
+    _globalIndices.shrink_to_fit();
+    _localIndices.clear();
+    _localIndices.shrink_to_fit();
+}
+
+bool GlobalIndexTable::isValid() const
+{
+    return _valid;
+}
+
+const std::vector<std::uint32_t>& GlobalIndexTable::getGlobalIndices() const
+{
+    return _globalIndices;
+}
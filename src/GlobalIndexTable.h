@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/**
+ * Global index table class
+ *
+ * Caches the mapping from local point indices of a (possibly derived) points dataset
+ * to global indices in its full dataset, together with the inverse lookup. Building
+ * the table costs one pass over the points, after which both directions are plain
+ * array lookups.
+ */
+class GlobalIndexTable
+{
+public:
+
+    /** Local index of global indices which are not part of the dataset */
+    static constexpr std::uint32_t INVALID_INDEX = std::numeric_limits<std::uint32_t>::max();
+
+public:
+
+    /** Default constructor */
+    GlobalIndexTable();
+
+    /**
+     * Build the table from \p localGlobalIndices (moved into the table)
+     * @param localGlobalIndices Global index per local point index
+     */
+    void build(std::vector<std::uint32_t>&& localGlobalIndices);
+
+    /** Release the table, it needs to be built again before use */
+    void invalidate();
+
+    /** Returns true when the table is built */
+    bool isValid() const;
+
+    /** Get the global index per local point index */
+    const std::vector<std::uint32_t>& getGlobalIndices() const;
+
+    /**
+     * Get the local index of \p globalIndex
+     * @param globalIndex Global point index
+     * @return Local point index, INVALID_INDEX when the point is not part of the dataset
+     */
+    std::uint32_t getLocalIndex(std::uint32_t globalIndex) const {
+        return globalIndex < _localIndices.size() ? _localIndices[globalIndex] : INVALID_INDEX;
+    }
+
+private:
+    bool                        _valid;             /** Whether the table is built */
+    std::vector<std::uint32_t>  _globalIndices;     /** Global index per local point index */
+    std::vector<std::uint32_t>  _localIndices;      /** Local index per global point index (up to the largest global index) */
+};
@@ -0,0 +1,150 @@
+#include "MappedFileCache.h"
+
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include <cstring>
+
+MappedFileCache::MappedFileCache(const QString& directory, std::uint64_t capacity) :
+    _directory(directory),
+    _capacity(capacity)
+{
+}
+
+bool MappedFileCache::storePositions(const QString& key, const std::vector<Vector2f>& positions, const Bounds& bounds) const
+{
+    const auto numberOfValues = 2 * positions.size();
+
+    if (numberOfValues == 0)
+        return false;
+
+    const auto size = sizeof(Header) + numberOfValues * sizeof(float);
+
+    if (size > _capacity || !QDir().mkpath(_directory))
+        return false;
+
+    const Header header{ MAGIC, FORMAT_VERSION, getChecksum(positions.data(), numberOfValues * sizeof(float)), numberOfValues, { bounds.getLeft(), bounds.getRight(), bounds.getBottom(), bounds.getTop() } };
+
+    // Write to a temporary file which replaces the cache file when complete, so that readers never see partial files
+    QSaveFile file(getFilePath(key));
+
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+
+    if (file.write(reinterpret_cast<const char*>(&header), sizeof(Header)) != static_cast<qint64>(sizeof(Header)) ||
+        file.write(reinterpret_cast<const char*>(positions.data()), numberOfValues * sizeof(float)) != static_cast<qint64>(numberOfValues * sizeof(float))) {
+        file.cancelWriting();
+        return false;
+    }
+
+    if (!file.commit())
+        return false;
+
+    evict();
+
+    return true;
+}
+
+bool MappedFileCache::loadPositions(const QString& key, std::vector<Vector2f>& positions, Bounds& bounds) const
+{
+    positions.clear();
+
+    QFile file(getFilePath(key));
+
+    if (!file.exists() || file.size() < static_cast<qint64>(sizeof(Header)) || !file.open(QIODevice::ReadOnly))
+        return false;
+
+    const auto size = static_cast<std::uint64_t>(file.size());
+
+    // The pages are read in on demand by the copy below
+    const auto data = file.map(0, file.size());
+
+    if (data == nullptr)
+        return false;
+
+    Header header;
+
+    std::memcpy(&header, data, sizeof(Header));
+
+    auto isLoaded = header.magic == MAGIC && header.formatVersion == FORMAT_VERSION && header.numberOfValues % 2 == 0 && size == sizeof(Header) + header.numberOfValues * sizeof(float);
+
+    if (isLoaded) {
+        positions.resize(header.numberOfValues / 2);
+
+        std::memcpy(positions.data(), data + sizeof(Header), header.numberOfValues * sizeof(float));
+
+        isLoaded = getChecksum(positions.data(), header.numberOfValues * sizeof(float)) == header.checksum;
+    }
+
+    file.unmap(data);
+    file.close();
+
+    // The key identifies the data, so a file which does not load is corrupt (or of an older format)
+    if (!isLoaded) {
+        qWarning() << "Removing invalid cache file" << file.fileName();
+
+        file.remove();
+        positions.clear();
+
+        return false;
+    }
+
+    bounds = Bounds(header.bounds[0], header.bounds[1], header.bounds[2], header.bounds[3]);
+
+    return true;
+}
+
+bool MappedFileCache::contains(const QString& key) const
+{
+    return QFileInfo::exists(getFilePath(key));
+}
+
+void MappedFileCache::clear() const
+{
+    QDir(_directory).removeRecursively();
+}
+
+QString MappedFileCache::getFilePath(const QString& key) const
+{
+    return QDir(_directory).filePath(QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Sha1).toHex() + ".cache");
+}
+
+void MappedFileCache::evict() const
+{
+    std::uint64_t size = 0;
+
+    // Newest first
+    for (const auto& fileInfo : QDir(_directory).entryInfoList({ "*.cache" }, QDir::Files, QDir::Time)) {
+        size += static_cast<std::uint64_t>(fileInfo.size());
+
+        if (size > _capacity)
+            QFile::remove(fileInfo.absoluteFilePath());
+    }
+}
+
+std::uint64_t MappedFileCache::getChecksum(const void* data, std::size_t size)
+{
+    const auto bytes = static_cast<const unsigned char*>(data);
+
+    std::uint64_t checksum = 0xCBF29CE484222325ull;
+
+    std::size_t offset = 0;
+
+    for (; offset + sizeof(std::uint64_t) <= size; offset += sizeof(std::uint64_t)) {
+        std::uint64_t word;
+
+        std::memcpy(&word, bytes + offset, sizeof(std::uint64_t));
+
+        checksum = (checksum ^ word) * 0x9E3779B97F4A7C15ull;
+        checksum ^= checksum >> 32;
+    }
+
+    for (; offset < size; offset++)
+        checksum = (checksum ^ bytes[offset]) * 0x100000001B3ull;
+
+    return checksum;
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "graphics/Vector2f.h"
+#include "graphics/Bounds.h"
+
+#include <QString>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using namespace mv;
+
+/**
+ * Mapped file cache class
+ *
+ * Persistent cache of extracted point positions (with their bounds), one file per key
+ * in a cache directory. Keys carry a version token of the data the positions were
+ * extracted from, which is replaced whenever the data changes, so a file never holds
+ * positions of other data. Each file carries a checksum of its payload; files are
+ * memory mapped on load and only used when it matches. The total size of the files
+ * is bounded, the least recently written files are removed first. The cache holds no
+ * state besides its directory, so it may be used from multiple threads.
+ */
+class MappedFileCache
+{
+public:
+
+    /**
+     * Construct with \p directory and \p capacity
+     * @param directory Directory of the cache files (created on the first store)
+     * @param capacity Maximum total size of the cache files (in bytes)
+     */
+    MappedFileCache(const QString& directory, std::uint64_t capacity);
+
+    /**
+     * Store \p positions with \p bounds under \p key
+     * @param key Key of the positions (including the version token of the data they were extracted from)
+     * @param positions Point positions
+     * @param bounds Bounds of the finite positions
+     * @return Whether the positions were stored
+     */
+    bool storePositions(const QString& key, const std::vector<Vector2f>& positions, const Bounds& bounds) const;
+
+    /**
+     * Load the positions and bounds stored under \p key
+     * @param key Key of the positions (including the version token of the current data)
+     * @param positions Point positions (output, cleared on a miss)
+     * @param bounds Bounds of the finite positions (output, only assigned on a hit)
+     * @return Whether valid positions were stored
+     */
+    bool loadPositions(const QString& key, std::vector<Vector2f>& positions, Bounds& bounds) const;
+
+    /**
+     * Returns true when a file is stored under \p key (which is not validated)
+     * @param key Key of the positions
+     */
+    bool contains(const QString& key) const;
+
+    /** Remove all cache files */
+    void clear() const;
+
+private:
+
+    /** Cache file header */
+    struct Header {
+        std::uint32_t   magic;              /** Identifies cache files */
+        std::uint32_t   formatVersion;      /** Version of the file format */
+        std::uint64_t   checksum;           /** Checksum of the values */
+        std::uint64_t   numberOfValues;     /** Number of float values after the header */
+        float           bounds[4];          /** Left, right, bottom and top bounds */
+    };
+
+    /** Get the path of the cache file of \p key */
+    QString getFilePath(const QString& key) const;
+
+    /** Remove the least recently written files until the cache fits its capacity */
+    void evict() const;
+
+    /** Get the checksum of \p size bytes at \p data */
+    static std::uint64_t getChecksum(const void* data, std::size_t size);
+
+private:
+    QString         _directory;     /** Directory of the cache files */
+    std::uint64_t   _capacity;      /** Maximum total size of the cache files (in bytes) */
+
+    static constexpr std::uint32_t  MAGIC               = 0x46435053;   /** File magic ("SPCF" in little-endian order) */
+    static constexpr std::uint32_t  FORMAT_VERSION      = 2;            /** Version of the file format */
+};
@@ -9,16 +9,40 @@ const QColor MiscellaneousAction::DEFAULT_BACKGROUND_COLOR = qRgb(255, 255, 255)
 MiscellaneousAction::MiscellaneousAction(QObject* parent, const QString& title) :
     VerticalGroupAction(parent, title),
     _scatterplotPlugin(dynamic_cast<ScatterplotPlugin*>(parent->parent())),
-    _backgroundColorAction(this, "Background color")
+    _backgroundColorAction(this, "Background color"),
+    _compactPositionCacheAction(this, "Compact position cache"),
+    _dataVersionTokenAction(this, "Data version token"),
+    _dataVersionTokenDatasetIdAction(this, "Data version token dataset id"),
+    _highlightsPatchRatioAction(this, "Highlights patch ratio", 0.0f, 1.0f, DEFAULT_HIGHLIGHTS_PATCH_RATIO, 2),
+    _levelOfDetailAction(this, "Level of detail", false),
+    _persistentCacheAction(this, "Persistent cache"),
+    _robustBoundsAction(this, "Robust bounds")
 {
     setIcon(Application::getIconFont("FontAwesome").getIcon("cog"));
     setLabelSizingType(LabelSizingType::Auto);
     setConfigurationFlag(WidgetAction::ConfigurationFlag::ForceCollapsedInGroup);
 
     addAction(&_backgroundColorAction);
+    addAction(&_compactPositionCacheAction);
+    addAction(&_highlightsPatchRatioAction);
+    addAction(&_levelOfDetailAction);
+    addAction(&_persistentCacheAction);
+    addAction(&_robustBoundsAction);
 
     _backgroundColorAction.setColor(DEFAULT_BACKGROUND_COLOR);
 
+    // The data version token is only saved with the project, it is neither shown nor shared with other views
+    _dataVersionTokenAction.setVisible(false);
+    _dataVersionTokenAction.setConnectionPermissionsToForceNone();
+    _dataVersionTokenDatasetIdAction.setVisible(false);
+    _dataVersionTokenDatasetIdAction.setConnectionPermissionsToForceNone();
+
+    _compactPositionCacheAction.setToolTip("Cache the positions of recently used dimensions with 16 bits per coordinate, which halves the memory but restores them with a small error");
+    _highlightsPatchRatioAction.setToolTip("Fraction of the points whose selection may change before all highlights are rebuilt instead of patching the changed ones (the renderer receives the complete highlights either way)");
+    _levelOfDetailAction.setToolTip("Draw datasets of ten million points or more as one point per occupied grid cell of about a pixel, with the mean color and the maximum size and opacity of its points");
+    _persistentCacheAction.setToolTip("Keep the extracted positions of datasets of a million points or more in files on disk, so that they load quickly when the project is opened again");
+    _robustBoundsAction.setToolTip("Fit the view to the 0.1 to 99.9 percentile range of each axis, so that a few outliers do not squash the other points into a corner");
+
     const auto updateBackgroundColor = [this]() -> void {
         _scatterplotPlugin->getScatterplotWidget().setBackgroundColor(_backgroundColorAction.getColor());
     };
@@ -35,6 +59,11 @@ QMenu* MiscellaneousAction::getContextMenu()
     auto menu = new QMenu("Miscellaneous");
 
     menu->addAction(&_backgroundColorAction);
+    menu->addAction(&_compactPositionCacheAction);
+    menu->addAction(&_highlightsPatchRatioAction);
+    menu->addAction(&_levelOfDetailAction);
+    menu->addAction(&_persistentCacheAction);
+    menu->addAction(&_robustBoundsAction);
 
     return menu;
 }
@@ -50,6 +79,11 @@ void MiscellaneousAction::connectToPublicAction(WidgetAction* publicAction, bool
 
     if (recursive) {
         actions().connectPrivateActionToPublicAction(&_backgroundColorAction, &publicMiscellaneousAction->getBackgroundColorAction(), recursive);
+        actions().connectPrivateActionToPublicAction(&_compactPositionCacheAction, &publicMiscellaneousAction->getCompactPositionCacheAction(), recursive);
+        actions().connectPrivateActionToPublicAction(&_highlightsPatchRatioAction, &publicMiscellaneousAction->getHighlightsPatchRatioAction(), recursive);
+        actions().connectPrivateActionToPublicAction(&_levelOfDetailAction, &publicMiscellaneousAction->getLevelOfDetailAction(), recursive);
+        actions().connectPrivateActionToPublicAction(&_persistentCacheAction, &publicMiscellaneousAction->getPersistentCacheAction(), recursive);
+        actions().connectPrivateActionToPublicAction(&_robustBoundsAction, &publicMiscellaneousAction->getRobustBoundsAction(), recursive);
     }
 
     GroupAction::connectToPublicAction(publicAction, recursive);
@@ -62,6 +96,11 @@ void MiscellaneousAction::disconnectFromPublicAction(bool recursive)
 
     if (recursive) {
         actions().disconnectPrivateActionFromPublicAction(&_backgroundColorAction, recursive);
+        actions().disconnectPrivateActionFromPublicAction(&_compactPositionCacheAction, recursive);
+        actions().disconnectPrivateActionFromPublicAction(&_highlightsPatchRatioAction, recursive);
+        actions().disconnectPrivateActionFromPublicAction(&_levelOfDetailAction, recursive);
+        actions().disconnectPrivateActionFromPublicAction(&_persistentCacheAction, recursive);
+        actions().disconnectPrivateActionFromPublicAction(&_robustBoundsAction, recursive);
     }
 
     GroupAction::disconnectFromPublicAction(recursive);
@@ -72,6 +111,13 @@ void MiscellaneousAction::fromVariantMap(const QVariantMap& variantMap)
     GroupAction::fromVariantMap(variantMap);
 
     _backgroundColorAction.fromParentVariantMap(variantMap);
+    _compactPositionCacheAction.fromParentVariantMap(variantMap);
+    _dataVersionTokenAction.fromParentVariantMap(variantMap);
+    _dataVersionTokenDatasetIdAction.fromParentVariantMap(variantMap);
+    _highlightsPatchRatioAction.fromParentVariantMap(variantMap);
+    _levelOfDetailAction.fromParentVariantMap(variantMap);
+    _persistentCacheAction.fromParentVariantMap(variantMap);
+    _robustBoundsAction.fromParentVariantMap(variantMap);
 }
 
 QVariantMap MiscellaneousAction::toVariantMap() const
@@ -79,6 +125,13 @@ QVariantMap MiscellaneousAction::toVariantMap() const
     auto variantMap = GroupAction::toVariantMap();
 
     _backgroundColorAction.insertIntoVariantMap(variantMap);
+    _compactPositionCacheAction.insertIntoVariantMap(variantMap);
+    _dataVersionTokenAction.insertIntoVariantMap(variantMap);
+    _dataVersionTokenDatasetIdAction.insertIntoVariantMap(variantMap);
+    _highlightsPatchRatioAction.insertIntoVariantMap(variantMap);
+    _levelOfDetailAction.insertIntoVariantMap(variantMap);
+    _persistentCacheAction.insertIntoVariantMap(variantMap);
+    _robustBoundsAction.insertIntoVariantMap(variantMap);
 
     return variantMap;
 }
\ No newline at end of file
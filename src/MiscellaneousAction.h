@@ -2,6 +2,9 @@
 
 #include <actions/VerticalGroupAction.h>
 #include <actions/ColorAction.h>
+#include <actions/DecimalAction.h>
+#include <actions/StringAction.h>
+#include <actions/ToggleAction.h>
 
 using namespace mv::gui;
 
@@ -65,12 +68,27 @@ public: // Serialization
 public: // Action getters
 
     ColorAction& getBackgroundColorAction() { return _backgroundColorAction; }
+    ToggleAction& getCompactPositionCacheAction() { return _compactPositionCacheAction; }
+    StringAction& getDataVersionTokenAction() { return _dataVersionTokenAction; }
+    StringAction& getDataVersionTokenDatasetIdAction() { return _dataVersionTokenDatasetIdAction; }
+    DecimalAction& getHighlightsPatchRatioAction() { return _highlightsPatchRatioAction; }
+    ToggleAction& getLevelOfDetailAction() { return _levelOfDetailAction; }
+    ToggleAction& getPersistentCacheAction() { return _persistentCacheAction; }
+    ToggleAction& getRobustBoundsAction() { return _robustBoundsAction; }
 
 private:
-    ScatterplotPlugin*  _scatterplotPlugin;         /** Pointer to scatter plot plugin */
-    ColorAction         _backgroundColorAction;     /** Color action for settings the background color action */
-
-    static const QColor DEFAULT_BACKGROUND_COLOR;
+    ScatterplotPlugin*  _scatterplotPlugin;                 /** Pointer to scatter plot plugin */
+    ColorAction         _backgroundColorAction;             /** Color action for settings the background color action */
+    ToggleAction        _compactPositionCacheAction;        /** Whether to cache positions of other dimensions quantized to 16 bits per coordinate */
+    StringAction        _dataVersionTokenAction;            /** Identifies the data of the position dataset in the persistent cache (hidden, cleared when the data changes) */
+    StringAction        _dataVersionTokenDatasetIdAction;   /** Identifier of the dataset which the data version token belongs to (hidden) */
+    DecimalAction       _highlightsPatchRatioAction;        /** Fraction of changed points up to which the highlights are patched instead of rebuilt */
+    ToggleAction        _levelOfDetailAction;               /** Whether to draw very large and dense datasets as aggregated grid cells */
+    ToggleAction        _persistentCacheAction;             /** Whether to cache extracted positions of large datasets on disk */
+    ToggleAction        _robustBoundsAction;                /** Whether to fit the view to the bulk of the points instead of all of them */
+
+    static const QColor     DEFAULT_BACKGROUND_COLOR;
+    static constexpr float  DEFAULT_HIGHLIGHTS_PATCH_RATIO = 0.25f;
 
     friend class mv::AbstractActionsManager;
 };
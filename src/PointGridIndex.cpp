@@ -0,0 +1,218 @@
+#include "PointGridIndex.h"
+
+#include <algorithm>
+#include <cmath>
+
+PointGridIndex::PointGridIndex() :
+    _bounds(),
+    _resolution(0),
+    _cellWidth(0.0f),
+    _cellHeight(0.0f),
+    _cellOffsets(),
+    _pointIndices()
+{
+}
+
+void PointGridIndex::build(const PositionView& positions, const Bounds& bounds)
+{
+    clear();
+
+    if (positions.empty() || bounds.getWidth() <= 0.0f || bounds.getHeight() <= 0.0f)
+        return;
+
+    const auto numberOfPoints = positions.size();
+
+    _bounds     = bounds;
+    _resolution = std::clamp(static_cast<std::uint32_t>(std::ceil(std::sqrt(static_cast<double>(numberOfPoints) / TARGET_POINTS_PER_CELL))), 1u, MAXIMUM_RESOLUTION);
+    _cellWidth  = _bounds.getWidth() / _resolution;
+    _cellHeight = _bounds.getHeight() / _resolution;
+
+    const auto numberOfCells = _resolution * _resolution;
+
+    // Cell index per point, non-finite points are not indexed
+    std::vector<std::uint32_t> pointCells(numberOfPoints, numberOfCells);
+
+    _cellOffsets.assign(numberOfCells + 1, 0);
+
+    for (std::uint32_t pointIndex = 0; pointIndex < numberOfPoints; pointIndex++) {
+        const auto x = positions.getX(pointIndex);
+        const auto y = positions.getY(pointIndex);
+
+        if (!std::isfinite(x) || !std::isfinite(y))
+            continue;
+
+        const auto cellIndex = getCellIndex(getColumn(x), getRow(y));
+
+        pointCells[pointIndex] = cellIndex;
+
+        _cellOffsets[cellIndex + 1]++;
+    }
+
+    for (std::uint32_t cellIndex = 0; cellIndex < numberOfCells; cellIndex++)
+        _cellOffsets[cellIndex + 1] += _cellOffsets[cellIndex];
+
+    // Counting sort, which keeps the point indices within a cell in ascending order
+    std::vector<std::uint32_t> cellCursors(_cellOffsets.begin(), _cellOffsets.end() - 1);
+
+    _pointIndices.resize(_cellOffsets.back());
+
+    for (std::uint32_t pointIndex = 0; pointIndex < numberOfPoints; pointIndex++) {
+        const auto cellIndex = pointCells[pointIndex];
+
+        if (cellIndex < numberOfCells)
+            _pointIndices[cellCursors[cellIndex]++] = pointIndex;
+    }
+}
+
+void PointGridIndex::clear()
+{
+    _bounds         = Bounds();
+    _resolution     = 0;
+    _cellWidth      = 0.0f;
+    _cellHeight     = 0.0f;
+
+    _cellOffsets.clear();
+    _pointIndices.clear();
+}
+
+bool PointGridIndex::isValid() const
+{
+    return _resolution > 0;
+}
+
+std::uint32_t PointGridIndex::getResolution() const
+{
+    return _resolution;
+}
+
+const Bounds& PointGridIndex::getBounds() const
+{
+    return _bounds;
+}
+
+std::size_t PointGridIndex::getSizeInBytes() const
+{
+    return (_cellOffsets.capacity() + _pointIndices.capacity()) * sizeof(std::uint32_t);
+}
+
+Bounds PointGridIndex::getCellBounds(std::uint32_t column, std::uint32_t row) const
+{
+    Bounds cellBounds;
+
+    cellBounds.setLeft(_bounds.getLeft() + column * _cellWidth);
+    cellBounds.setRight(_bounds.getLeft() + (column + 1) * _cellWidth);
+    cellBounds.setBottom(_bounds.getBottom() + row * _cellHeight);
+    cellBounds.setTop(_bounds.getBottom() + (row + 1) * _cellHeight);
+
+    return cellBounds;
+}
+
+bool PointGridIndex::getCellRange(const Bounds& region, std::uint32_t& columnMin, std::uint32_t& columnMax, std::uint32_t& rowMin, std::uint32_t& rowMax) const
+{
+    if (!isValid())
+        return false;
+
+    if (region.getRight() < _bounds.getLeft() || region.getLeft() > _bounds.getRight())
+        return false;
+
+    if (region.getTop() < _bounds.getBottom() || region.getBottom() > _bounds.getTop())
+        return false;
+
+    columnMin   = getColumn(region.getLeft());
+    columnMax   = getColumn(region.getRight());
+    rowMin      = getRow(region.getBottom());
+    rowMax      = getRow(region.getTop());
+
+    return true;
+}
+
+bool PointGridIndex::findNearest(const PositionView& positions, const Vector2f& position, float radius, std::uint32_t& nearestIndex) const
+{
+    Bounds region;
+
+    region.setLeft(position.x - radius);
+    region.setRight(position.x + radius);
+    region.setBottom(position.y - radius);
+    region.setTop(position.y + radius);
+
+    std::uint32_t columnMin = 0, columnMax = 0, rowMin = 0, rowMax = 0;
+
+    if (!getCellRange(region, columnMin, columnMax, rowMin, rowMax))
+        return false;
+
+    auto nearestDistanceSquared = radius * radius;
+    auto found                  = false;
+
+    for (auto row = rowMin; row <= rowMax; row++) {
+        for (auto column = columnMin; column <= columnMax; column++) {
+            const auto cellIndex = getCellIndex(column, row);
+
+            for (auto pointIndex = cellBegin(cellIndex); pointIndex != cellEnd(cellIndex); ++pointIndex) {
+                const auto deltaX           = positions.getX(*pointIndex) - position.x;
+                const auto deltaY           = positions.getY(*pointIndex) - position.y;
+                const auto distanceSquared  = deltaX * deltaX + deltaY * deltaY;
+
+                if (distanceSquared > nearestDistanceSquared)
+                    continue;
+
+                nearestDistanceSquared  = distanceSquared;
+                nearestIndex            = *pointIndex;
+                found                   = true;
+            }
+        }
+    }
+
+    return found;
+}
+
+std::vector<std::uint32_t> PointGridIndex::findWithinRadius(const PositionView& positions, const Vector2f& position, float radius) const
+{
+    std::vector<std::uint32_t> indices;
+
+    Bounds region;
+
+    region.setLeft(position.x - radius);
+    region.setRight(position.x + radius);
+    region.setBottom(position.y - radius);
+    region.setTop(position.y + radius);
+
+    std::uint32_t columnMin = 0, columnMax = 0, rowMin = 0, rowMax = 0;
+
+    if (!getCellRange(region, columnMin, columnMax, rowMin, rowMax))
+        return indices;
+
+    const auto radiusSquared = radius * radius;
+
+    for (auto row = rowMin; row <= rowMax; row++) {
+        for (auto column = columnMin; column <= columnMax; column++) {
+            const auto cellIndex = getCellIndex(column, row);
+
+            for (auto pointIndex = cellBegin(cellIndex); pointIndex != cellEnd(cellIndex); ++pointIndex) {
+                const auto deltaX = positions.getX(*pointIndex) - position.x;
+                const auto deltaY = positions.getY(*pointIndex) - position.y;
+
+                if (deltaX * deltaX + deltaY * deltaY <= radiusSquared)
+                    indices.push_back(*pointIndex);
+            }
+        }
+    }
+
+    // Indices are only sorted within a cell
+    std::sort(indices.begin(), indices.end());
+
+    return indices;
+}
+
+std::uint32_t PointGridIndex::getColumn(float x) const
+{
+    const auto column = std::floor((x - _bounds.getLeft()) / _cellWidth);
+
+    return static_cast<std::uint32_t>(std::clamp(column, 0.0f, static_cast<float>(_resolution - 1)));
+}
+
+std::uint32_t PointGridIndex::getRow(float y) const
+{
+    const auto row = std::floor((y - _bounds.getBottom()) / _cellHeight);
+
+    return static_cast<std::uint32_t>(std::clamp(row, 0.0f, static_cast<float>(_resolution - 1)));
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "PositionView.h"
+
+#include "graphics/Vector2f.h"
+#include "graphics/Bounds.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using namespace mv;
+
+/**
+ * Point grid index class
+ *
+ * Uniform grid over the point positions which buckets the point indices per cell,
+ * so that spatial queries (e.g. selection hit testing) only visit the cells they touch
+ */
+class PointGridIndex
+{
+public:
+
+    /** Default constructor */
+    PointGridIndex();
+
+    /**
+     * Build the index for \p positions which lie inside \p bounds
+     * @param positions Point positions
+     * @param bounds Bounds of the grid (points outside are clamped to the border cells)
+     */
+    void build(const PositionView& positions, const Bounds& bounds);
+
+    /** Release the index */
+    void clear();
+
+    /** Returns true when the index is built */
+    bool isValid() const;
+
+    /** Get the number of cells along each axis */
+    std::uint32_t getResolution() const;
+
+    /** Get the bounds of the grid */
+    const Bounds& getBounds() const;
+
+    /** Get the size of the index (in bytes) */
+    std::size_t getSizeInBytes() const;
+
+    /**
+     * Get the bounds of cell at \p column and \p row
+     * @param column Cell column (x-axis)
+     * @param row Cell row (y-axis, bottom to top)
+     * @return Cell bounds in data space
+     */
+    Bounds getCellBounds(std::uint32_t column, std::uint32_t row) const;
+
+    /**
+     * Get the range of cells which overlaps with \p region (clamped to the grid)
+     * @param region Region in data space
+     * @param columnMin Minimum column (output)
+     * @param columnMax Maximum column (output, inclusive)
+     * @param rowMin Minimum row (output)
+     * @param rowMax Maximum row (output, inclusive)
+     * @return Whether the region overlaps with the grid at all
+     */
+    bool getCellRange(const Bounds& region, std::uint32_t& columnMin, std::uint32_t& columnMax, std::uint32_t& rowMin, std::uint32_t& rowMax) const;
+
+    /**
+     * Find the point nearest to \p position within \p radius
+     * @param positions Point positions the index was built for
+     * @param position Query position in data space
+     * @param radius Search radius in data space
+     * @param nearestIndex Local index of the nearest point (output)
+     * @return Whether a point was found within the radius
+     */
+    bool findNearest(const PositionView& positions, const Vector2f& position, float radius, std::uint32_t& nearestIndex) const;
+
+    /**
+     * Find all points within \p radius of \p position
+     * @param positions Point positions the index was built for
+     * @param position Query position in data space
+     * @param radius Search radius in data space
+     * @return Local indices of the points within the radius (sorted in ascending order)
+     */
+    std::vector<std::uint32_t> findWithinRadius(const PositionView& positions, const Vector2f& position, float radius) const;
+
+    /** Get the linear index of the cell at \p column and \p row */
+    std::uint32_t getCellIndex(std::uint32_t column, std::uint32_t row) const {
+        return row * _resolution + column;
+    }
+
+    /** Get the number of points in cell with \p cellIndex */
+    std::uint32_t getNumberOfPointsInCell(std::uint32_t cellIndex) const {
+        return _cellOffsets[cellIndex + 1] - _cellOffsets[cellIndex];
+    }
+
+    /** Get pointer to the first (local) point index in cell with \p cellIndex (indices are sorted in ascending order) */
+    const std::uint32_t* cellBegin(std::uint32_t cellIndex) const {
+        return _pointIndices.data() + _cellOffsets[cellIndex];
+    }
+
+    /** Get pointer past the last (local) point index in cell with \p cellIndex */
+    const std::uint32_t* cellEnd(std::uint32_t cellIndex) const {
+        return _pointIndices.data() + _cellOffsets[cellIndex + 1];
+    }
+
+private:
+
+    /** Get the column of data space coordinate \p x (clamped to the grid) */
+    std::uint32_t getColumn(float x) const;
+
+    /** Get the row of data space coordinate \p y (clamped to the grid) */
+    std::uint32_t getRow(float y) const;
+
+private:
+    Bounds                      _bounds;            /** Bounds of the grid in data space */
+    std::uint32_t               _resolution;        /** Number of cells along each axis */
+    float                       _cellWidth;         /** Width of a cell in data space */
+    float                       _cellHeight;        /** Height of a cell in data space */
+    std::vector<std::uint32_t>  _cellOffsets;       /** Offset of each cell in the point indices (number of cells + 1) */
+    std::vector<std::uint32_t>  _pointIndices;      /** Local point indices, sorted by cell */
+
+    static constexpr std::uint32_t TARGET_POINTS_PER_CELL   = 64;      /** Average number of points per cell the resolution aims for */
+    static constexpr std::uint32_t MAXIMUM_RESOLUTION       = 1024;    /** Maximum number of cells along each axis */
+};
@@ -0,0 +1,339 @@
+#include "PointGridPyramid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+PointGridPyramid::PointGridPyramid() :
+    _bounds(),
+    _numberOfPoints(0),
+    _numberOfLevels(0),
+    _pointCells(),
+    _cellCodes(),
+    _cellCounts(),
+    _cellPositions()
+{
+}
+
+void PointGridPyramid::build(const PositionView& positions, const Bounds& bounds)
+{
+    clear();
+
+    if (positions.empty() || bounds.getWidth() <= 0.0f || bounds.getHeight() <= 0.0f)
+        return;
+
+    const auto numberOfPoints   = static_cast<std::uint32_t>(positions.size());
+    const auto scaleX           = FINEST_RESOLUTION / bounds.getWidth();
+    const auto scaleY           = FINEST_RESOLUTION / bounds.getHeight();
+    const auto resolution       = static_cast<float>(FINEST_RESOLUTION);
+
+    // Number of points per Z-order code, later replaced by the index of the occupied cell
+    std::vector<std::uint32_t> codeCells(static_cast<std::size_t>(FINEST_RESOLUTION) * FINEST_RESOLUTION, 0);
+
+    _pointCells.assign(numberOfPoints, NO_CELL);
+
+    for (std::uint32_t pointIndex = 0; pointIndex < numberOfPoints; pointIndex++) {
+        const auto x = positions.getX(pointIndex);
+        const auto y = positions.getY(pointIndex);
+
+        if (!std::isfinite(x) || !std::isfinite(y))
+            continue;
+
+        const auto cellX = (x - bounds.getLeft()) * scaleX;
+        const auto cellY = (y - bounds.getBottom()) * scaleY;
+
+        // Points outside would drag the means of the border cells away from them
+        if (cellX < 0.0f || cellY < 0.0f || cellX > resolution || cellY > resolution)
+            continue;
+
+        const auto column   = std::min(static_cast<std::uint32_t>(cellX), FINEST_RESOLUTION - 1);
+        const auto row      = std::min(static_cast<std::uint32_t>(cellY), FINEST_RESOLUTION - 1);
+        const auto code     = getCode(column, row);
+
+        _pointCells[pointIndex] = code;
+
+        codeCells[code]++;
+    }
+
+    // Number the occupied cells in Z-order
+    for (std::uint32_t code = 0; code < codeCells.size(); code++) {
+        if (codeCells[code] == 0)
+            continue;
+
+        _cellCodes.push_back(code);
+        _cellCounts.push_back(codeCells[code]);
+
+        codeCells[code] = static_cast<std::uint32_t>(_cellCodes.size()) - 1;
+    }
+
+    if (_cellCodes.empty()) {
+        clear();
+        return;
+    }
+
+    _cellPositions.assign(_cellCodes.size(), Vector2f(0.0f, 0.0f));
+
+    for (std::uint32_t pointIndex = 0; pointIndex < numberOfPoints; pointIndex++) {
+        if (_pointCells[pointIndex] == NO_CELL)
+            continue;
+
+        const auto cellIndex = codeCells[_pointCells[pointIndex]];
+
+        _pointCells[pointIndex] = cellIndex;
+
+        _cellPositions[cellIndex].x += positions.getX(pointIndex);
+        _cellPositions[cellIndex].y += positions.getY(pointIndex);
+    }
+
+    for (std::uint32_t cellIndex = 0; cellIndex < _cellCodes.size(); cellIndex++) {
+        _cellPositions[cellIndex].x /= _cellCounts[cellIndex];
+        _cellPositions[cellIndex].y /= _cellCounts[cellIndex];
+    }
+
+    _bounds         = bounds;
+    _numberOfPoints = numberOfPoints;
+    _numberOfLevels = 1;
+
+    while ((FINEST_RESOLUTION >> _numberOfLevels) >= COARSEST_RESOLUTION)
+        _numberOfLevels++;
+}
+
+void PointGridPyramid::clear()
+{
+    _bounds         = Bounds();
+    _numberOfPoints = 0;
+    _numberOfLevels = 0;
+
+    _pointCells.clear();
+    _cellCodes.clear();
+    _cellCounts.clear();
+    _cellPositions.clear();
+}
+
+bool PointGridPyramid::isValid() const
+{
+    return _numberOfLevels > 0;
+}
+
+Bounds PointGridPyramid::getBounds() const
+{
+    return _bounds;
+}
+
+std::uint32_t PointGridPyramid::getNumberOfPoints() const
+{
+    return _numberOfPoints;
+}
+
+std::uint32_t PointGridPyramid::getNumberOfLevels() const
+{
+    return _numberOfLevels;
+}
+
+std::uint32_t PointGridPyramid::getResolution(std::uint32_t level) const
+{
+    return FINEST_RESOLUTION >> level;
+}
+
+std::uint32_t PointGridPyramid::findLevel(std::uint32_t resolution) const
+{
+    std::uint32_t level = 0;
+
+    while (level + 1 < _numberOfLevels && getResolution(level + 1) >= resolution)
+        level++;
+
+    return level;
+}
+
+std::uint32_t PointGridPyramid::getNumberOfCells(std::uint32_t level) const
+{
+    return static_cast<std::uint32_t>(getCellOffsets(level).size()) - 1;
+}
+
+std::vector<Vector2f> PointGridPyramid::getPositions(std::uint32_t level) const
+{
+    const auto cellOffsets = getCellOffsets(level);
+
+    std::vector<Vector2f> positions(cellOffsets.size() - 1);
+
+    for (std::size_t cellIndex = 0; cellIndex < positions.size(); cellIndex++) {
+        double x = 0.0, y = 0.0, count = 0.0;
+
+        for (auto finestIndex = cellOffsets[cellIndex]; finestIndex < cellOffsets[cellIndex + 1]; finestIndex++) {
+            x       += static_cast<double>(_cellPositions[finestIndex].x) * _cellCounts[finestIndex];
+            y       += static_cast<double>(_cellPositions[finestIndex].y) * _cellCounts[finestIndex];
+            count   += _cellCounts[finestIndex];
+        }
+
+        positions[cellIndex] = Vector2f(static_cast<float>(x / count), static_cast<float>(y / count));
+    }
+
+    return positions;
+}
+
+std::vector<Vector3f> PointGridPyramid::aggregateColors(const std::vector<Vector3f>& colors) const
+{
+    std::vector<Vector3f> cellColors;
+
+    if (!isValid() || colors.size() != _numberOfPoints)
+        return cellColors;
+
+    cellColors.assign(_cellCodes.size(), Vector3f(0.0f, 0.0f, 0.0f));
+
+    for (std::uint32_t pointIndex = 0; pointIndex < _numberOfPoints; pointIndex++) {
+        const auto cellIndex = _pointCells[pointIndex];
+
+        if (cellIndex == NO_CELL)
+            continue;
+
+        cellColors[cellIndex].x += colors[pointIndex].x;
+        cellColors[cellIndex].y += colors[pointIndex].y;
+        cellColors[cellIndex].z += colors[pointIndex].z;
+    }
+
+    for (std::uint32_t cellIndex = 0; cellIndex < _cellCodes.size(); cellIndex++) {
+        cellColors[cellIndex].x /= _cellCounts[cellIndex];
+        cellColors[cellIndex].y /= _cellCounts[cellIndex];
+        cellColors[cellIndex].z /= _cellCounts[cellIndex];
+    }
+
+    return cellColors;
+}
+
+std::vector<Vector3f> PointGridPyramid::getColors(const std::vector<Vector3f>& cellColors, std::uint32_t level) const
+{
+    const auto cellOffsets = getCellOffsets(level);
+
+    std::vector<Vector3f> colors(cellOffsets.size() - 1);
+
+    if (cellColors.size() != _cellCodes.size())
+        return colors;
+
+    for (std::size_t cellIndex = 0; cellIndex < colors.size(); cellIndex++) {
+        float r = 0.0f, g = 0.0f, b = 0.0f, count = 0.0f;
+
+        for (auto finestIndex = cellOffsets[cellIndex]; finestIndex < cellOffsets[cellIndex + 1]; finestIndex++) {
+            r       += cellColors[finestIndex].x * _cellCounts[finestIndex];
+            g       += cellColors[finestIndex].y * _cellCounts[finestIndex];
+            b       += cellColors[finestIndex].z * _cellCounts[finestIndex];
+            count   += _cellCounts[finestIndex];
+        }
+
+        colors[cellIndex] = Vector3f(r / count, g / count, b / count);
+    }
+
+    return colors;
+}
+
+std::vector<float> PointGridPyramid::aggregateScalars(const std::vector<float>& scalars) const
+{
+    std::vector<float> cellScalars;
+
+    if (!isValid() || scalars.size() != _numberOfPoints)
+        return cellScalars;
+
+    cellScalars.assign(_cellCodes.size(), -std::numeric_limits<float>::infinity());
+
+    for (std::uint32_t pointIndex = 0; pointIndex < _numberOfPoints; pointIndex++) {
+        const auto cellIndex = _pointCells[pointIndex];
+
+        if (cellIndex != NO_CELL)
+            cellScalars[cellIndex] = std::max(cellScalars[cellIndex], scalars[pointIndex]);
+    }
+
+    return cellScalars;
+}
+
+std::vector<float> PointGridPyramid::getScalars(const std::vector<float>& cellScalars, std::uint32_t level) const
+{
+    const auto cellOffsets = getCellOffsets(level);
+
+    std::vector<float> scalars(cellOffsets.size() - 1, 0.0f);
+
+    if (cellScalars.size() != _cellCodes.size())
+        return scalars;
+
+    for (std::size_t cellIndex = 0; cellIndex < scalars.size(); cellIndex++)
+        scalars[cellIndex] = *std::max_element(cellScalars.begin() + cellOffsets[cellIndex], cellScalars.begin() + cellOffsets[cellIndex + 1]);
+
+    return scalars;
+}
+
+std::vector<char> PointGridPyramid::aggregateHighlights(const std::vector<char>& highlights) const
+{
+    std::vector<char> cellHighlights;
+
+    if (!isValid() || highlights.size() != _numberOfPoints)
+        return cellHighlights;
+
+    cellHighlights.assign(_cellCodes.size(), 0);
+
+    for (std::uint32_t pointIndex = 0; pointIndex < _numberOfPoints; pointIndex++) {
+        const auto cellIndex = _pointCells[pointIndex];
+
+        if (cellIndex != NO_CELL && highlights[pointIndex])
+            cellHighlights[cellIndex] = 1;
+    }
+
+    return cellHighlights;
+}
+
+std::vector<char> PointGridPyramid::getHighlights(const std::vector<char>& cellHighlights, std::uint32_t level, std::int32_t& numberOfHighlightedCells) const
+{
+    const auto cellOffsets = getCellOffsets(level);
+
+    std::vector<char> highlights(cellOffsets.size() - 1, 0);
+
+    numberOfHighlightedCells = 0;
+
+    if (cellHighlights.size() != _cellCodes.size())
+        return highlights;
+
+    for (std::size_t cellIndex = 0; cellIndex < highlights.size(); cellIndex++) {
+        const auto isHighlighted = std::any_of(cellHighlights.begin() + cellOffsets[cellIndex], cellHighlights.begin() + cellOffsets[cellIndex + 1], [](char highlight) -> bool {
+            return highlight != 0;
+        });
+
+        highlights[cellIndex] = isHighlighted ? 1 : 0;
+
+        if (isHighlighted)
+            numberOfHighlightedCells++;
+    }
+
+    return highlights;
+}
+
+std::vector<std::uint32_t> PointGridPyramid::getCellOffsets(std::uint32_t level) const
+{
+    std::vector<std::uint32_t> cellOffsets;
+
+    if (!isValid())
+        return { 0 };
+
+    // The parent code of a cell drops two bits per level, so the cells of a level are runs of consecutive finest cells
+    const auto shift = 2 * std::min(level, _numberOfLevels - 1);
+
+    cellOffsets.reserve(_cellCodes.size() + 1);
+
+    for (std::uint32_t finestIndex = 0; finestIndex < _cellCodes.size(); finestIndex++)
+        if (finestIndex == 0 || (_cellCodes[finestIndex] >> shift) != (_cellCodes[finestIndex - 1] >> shift))
+            cellOffsets.push_back(finestIndex);
+
+    cellOffsets.push_back(static_cast<std::uint32_t>(_cellCodes.size()));
+
+    return cellOffsets;
+}
+
+std::uint32_t PointGridPyramid::getCode(std::uint32_t column, std::uint32_t row)
+{
+    const auto spread = [](std::uint32_t value) -> std::uint32_t {
+        value = (value | (value << 8)) & 0x00FF00FF;
+        value = (value | (value << 4)) & 0x0F0F0F0F;
+        value = (value | (value << 2)) & 0x33333333;
+        value = (value | (value << 1)) & 0x55555555;
+
+        return value;
+    };
+
+    return spread(column) | (spread(row) << 1);
+}
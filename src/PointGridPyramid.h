@@ -0,0 +1,136 @@
+#pragma once
+
+#include "PositionView.h"
+
+#include "graphics/Vector2f.h"
+#include "graphics/Vector3f.h"
+#include "graphics/Bounds.h"
+
+#include <cstdint>
+#include <vector>
+
+using namespace mv;
+
+/**
+ * Point grid pyramid class
+ *
+ * Sparse multi-resolution grid over the point positions which aggregates the points and their
+ * attributes per occupied cell, so that dense point sets can be drawn as a single point per cell.
+ * The occupied cells of the finest level are ordered along the Z-order curve, so the cells of
+ * each coarser level are contiguous runs of finest cells. Point attributes are aggregated per
+ * finest cell by the caller, the pyramid itself does not change once it is built, so it may be
+ * shared between threads.
+ */
+class PointGridPyramid
+{
+public:
+
+    /** Default constructor */
+    PointGridPyramid();
+
+    /**
+     * Build the pyramid for \p positions which lie inside \p bounds
+     * @param positions Point positions
+     * @param bounds Bounds of the grid (points outside are not aggregated)
+     */
+    void build(const PositionView& positions, const Bounds& bounds);
+
+    /** Release the pyramid */
+    void clear();
+
+    /** Returns true when the pyramid is built */
+    bool isValid() const;
+
+    /** Get the bounds of the grid */
+    Bounds getBounds() const;
+
+    /** Get the number of points the pyramid was built for */
+    std::uint32_t getNumberOfPoints() const;
+
+    /** Get the number of levels (level zero is the finest) */
+    std::uint32_t getNumberOfLevels() const;
+
+    /** Get the number of cells along each axis at \p level */
+    std::uint32_t getResolution(std::uint32_t level) const;
+
+    /**
+     * Find the coarsest level with at least \p resolution cells along each axis
+     * @param resolution Minimum number of cells along each axis (e.g. the size of the viewport in pixels)
+     * @return Level (the finest level when no level is fine enough)
+     */
+    std::uint32_t findLevel(std::uint32_t resolution) const;
+
+    /** Get the number of occupied cells at \p level */
+    std::uint32_t getNumberOfCells(std::uint32_t level) const;
+
+    /** Get the mean position of the points per occupied cell at \p level */
+    std::vector<Vector2f> getPositions(std::uint32_t level) const;
+
+    /**
+     * Aggregate the point \p colors to mean colors per finest occupied cell
+     * @param colors Color per point
+     * @return Mean color per finest occupied cell (empty when the number of colors does not match)
+     */
+    std::vector<Vector3f> aggregateColors(const std::vector<Vector3f>& colors) const;
+
+    /**
+     * Get the mean color of the points per occupied cell at \p level
+     * @param cellColors Mean color per finest occupied cell (see aggregateColors())
+     * @param level Level
+     * @return Mean color per cell
+     */
+    std::vector<Vector3f> getColors(const std::vector<Vector3f>& cellColors, std::uint32_t level) const;
+
+    /**
+     * Aggregate the point \p scalars to maximum scalars per finest occupied cell
+     * @param scalars Scalar per point
+     * @return Maximum scalar per finest occupied cell (empty when the number of scalars does not match)
+     */
+    std::vector<float> aggregateScalars(const std::vector<float>& scalars) const;
+
+    /**
+     * Get the maximum scalar of the points per occupied cell at \p level
+     * @param cellScalars Maximum scalar per finest occupied cell (see aggregateScalars())
+     * @param level Level
+     * @return Maximum scalar per cell
+     */
+    std::vector<float> getScalars(const std::vector<float>& cellScalars, std::uint32_t level) const;
+
+    /**
+     * Aggregate the point \p highlights, a cell is highlighted when any of its points is
+     * @param highlights Highlight per point
+     * @return Highlight per finest occupied cell (empty when the number of highlights does not match)
+     */
+    std::vector<char> aggregateHighlights(const std::vector<char>& highlights) const;
+
+    /**
+     * Get the highlight per occupied cell at \p level
+     * @param cellHighlights Highlight per finest occupied cell (see aggregateHighlights())
+     * @param level Level
+     * @param numberOfHighlightedCells Number of highlighted cells (output)
+     * @return Highlight per cell
+     */
+    std::vector<char> getHighlights(const std::vector<char>& cellHighlights, std::uint32_t level, std::int32_t& numberOfHighlightedCells) const;
+
+private:
+
+    /** Get the range of finest cells which make up the cells at \p level (number of cells + 1 offsets) */
+    std::vector<std::uint32_t> getCellOffsets(std::uint32_t level) const;
+
+    /** Interleave the bits of \p column and \p row into a Z-order code */
+    static std::uint32_t getCode(std::uint32_t column, std::uint32_t row);
+
+private:
+    Bounds                                  _bounds;            /** Bounds of the grid */
+    std::uint32_t                           _numberOfPoints;    /** Number of points the pyramid was built for */
+    std::uint32_t                           _numberOfLevels;    /** Number of levels */
+    std::vector<std::uint32_t>              _pointCells;        /** Finest occupied cell per point (NO_CELL for points which are not aggregated) */
+    std::vector<std::uint32_t>              _cellCodes;         /** Z-order code per finest occupied cell (ascending) */
+    std::vector<std::uint32_t>              _cellCounts;        /** Number of points per finest occupied cell */
+    std::vector<Vector2f>                   _cellPositions;     /** Mean point position per finest occupied cell */
+
+public:
+    static constexpr std::uint32_t NO_CELL              = 0xFFFFFFFF;   /** Cell of points which are not aggregated */
+    static constexpr std::uint32_t FINEST_RESOLUTION    = 2048;         /** Number of cells along each axis at the finest level (a power of two) */
+    static constexpr std::uint32_t COARSEST_RESOLUTION  = 64;           /** Number of cells along each axis at the coarsest level */
+};
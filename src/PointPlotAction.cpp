@@ -12,8 +12,8 @@ PointPlotAction::PointPlotAction(QObject* parent, const QString& title) :
     _scatterplotPlugin(nullptr),
     _sizeAction(this, "Point size", 0.0, 100.0, DEFAULT_POINT_SIZE),
     _opacityAction(this, "Point opacity", 0.0, 100.0, DEFAULT_POINT_OPACITY),
-    _pointSizeScalars(),
-    _pointOpacityScalars(),
+    _pointSizeScalars(std::make_shared<std::vector<float>>()),
+    _pointOpacityScalars(std::make_shared<std::vector<float>>()),
     _focusSelection(this, "Focus selection"),
     _lastOpacitySourceIndex(-1)
 {
@@ -142,8 +142,8 @@ void PointPlotAction::initialize(ScatterplotPlugin* scatterplotPlugin)
 
         updateDefaultDatasets();
 
-        updateScatterPlotWidgetPointSizeScalars();
-        updateScatterPlotWidgetPointOpacityScalars();
+        // Size and opacity scalars are updated together with the positions of the new dataset
+        _scatterplotPlugin->requestUpdate(ScatterplotPlugin::PointSize | ScatterplotPlugin::PointOpacity);
 
         _sizeAction.getSourceAction().getPickerAction().setCurrentIndex(0);
         _opacityAction.getSourceAction().getPickerAction().setCurrentIndex(0);
@@ -151,8 +151,20 @@ void PointPlotAction::initialize(ScatterplotPlugin* scatterplotPlugin)
 
     connect(&_scatterplotPlugin->getPositionDataset(), &Dataset<Points>::childAdded, this, &PointPlotAction::updateDefaultDatasets);
     connect(&_scatterplotPlugin->getPositionDataset(), &Dataset<Points>::childRemoved, this, &PointPlotAction::updateDefaultDatasets);
-    connect(&_scatterplotPlugin->getPositionDataset(), &Dataset<Points>::dataSelectionChanged, this, &PointPlotAction::updateScatterPlotWidgetPointSizeScalars);
-    connect(&_scatterplotPlugin->getPositionDataset(), &Dataset<Points>::dataSelectionChanged, this, &PointPlotAction::updateScatterPlotWidgetPointOpacityScalars);
+
+    // Only scalars which are sourced from the selection depend on it
+    connect(_scatterplotPlugin, &ScatterplotPlugin::localSelectionChanged, this, [this]() -> void {
+
+        // The local selection is emitted again once the current positions are swapped in
+        if (!_scatterplotPlugin->hasCurrentPositions())
+            return;
+
+        if (_sizeAction.isSourceSelection())
+            updateScatterPlotWidgetPointSizeScalars();
+
+        if (_opacityAction.isSourceSelection())
+            updateScatterPlotWidgetPointOpacityScalars();
+    });
 
     connect(&_sizeAction, &ScalarAction::magnitudeChanged, this, &PointPlotAction::updateScatterPlotWidgetPointSizeScalars);
     connect(&_sizeAction, &ScalarAction::offsetChanged, this, &PointPlotAction::updateScatterPlotWidgetPointSizeScalars);
@@ -240,6 +252,11 @@ void PointPlotAction::updateDefaultDatasets()
 }
 
 void PointPlotAction::updateScatterPlotWidgetPointSizeScalars()
+{
+    updatePointSizeScalars(0);
+}
+
+void PointPlotAction::updatePointSizeScalars(std::uint32_t begin)
 {
     if (_scatterplotPlugin == nullptr)
         return;
@@ -249,27 +266,31 @@ void PointPlotAction::updateScatterPlotWidgetPointSizeScalars()
 
     const auto numberOfPoints = _scatterplotPlugin->getPositionDataset()->getNumPoints();
 
-    if (numberOfPoints != _pointSizeScalars.size())
-        _pointSizeScalars.resize(numberOfPoints);
+    begin = std::min(begin, numberOfPoints);
 
-    std::fill(_pointSizeScalars.begin(), _pointSizeScalars.end(), _sizeAction.getMagnitudeAction().getValue());
+    // The widget may still aggregate the previous scalars on the thread pool, so these are copied instead of modified in place
+    if (_pointSizeScalars.use_count() > 1)
+        _pointSizeScalars = std::make_shared<std::vector<float>>(*_pointSizeScalars);
 
-    if (_sizeAction.isSourceSelection()) {
-        auto positionDataset = _scatterplotPlugin->getPositionDataset();
+    auto& pointSizeScalars = *_pointSizeScalars;
 
-        std::fill(_pointSizeScalars.begin(), _pointSizeScalars.end(), _sizeAction.getMagnitudeAction().getValue());
+    if (numberOfPoints != pointSizeScalars.size())
+        pointSizeScalars.resize(numberOfPoints);
 
-        const auto pointSizeSelectedPoints = _sizeAction.getMagnitudeAction().getValue() + _sizeAction.getSourceAction().getOffsetAction().getValue();
+    std::fill(pointSizeScalars.begin() + begin, pointSizeScalars.end(), _sizeAction.getMagnitudeAction().getValue());
 
-        std::vector<bool> selected;
+    if (_sizeAction.isSourceSelection()) {
+        std::fill(pointSizeScalars.begin() + begin, pointSizeScalars.end(), _sizeAction.getMagnitudeAction().getValue());
 
-        positionDataset->selectedLocalIndices(positionDataset->getSelection<Points>()->indices, selected);
+        const auto pointSizeSelectedPoints = _sizeAction.getMagnitudeAction().getValue() + _sizeAction.getSourceAction().getOffsetAction().getValue();
 
-        for (int i = 0; i < selected.size(); i++) {
-            if (!selected[i])
-                continue;
+        const auto& localSelection = _scatterplotPlugin->getLocalSelection();
 
-            _pointSizeScalars[i] = pointSizeSelectedPoints;
+        if (localSelection.getNumberOfPoints() == numberOfPoints) {
+            localSelection.forEachSelected([&pointSizeScalars, pointSizeSelectedPoints, begin](std::uint32_t localIndex) -> void {
+                if (localIndex >= begin)
+                    pointSizeScalars[localIndex] = pointSizeSelectedPoints;
+            });
         }
     }
 
@@ -279,24 +300,24 @@ void PointPlotAction::updateScatterPlotWidgetPointSizeScalars()
 
         if (pointSizeSourceDataset.isValid() && pointSizeSourceDataset->getNumPoints() == _scatterplotPlugin->getPositionDataset()->getNumPoints())
         {
-            pointSizeSourceDataset->visitData([this, pointSizeSourceDataset, numberOfPoints](auto pointData) {
+            pointSizeSourceDataset->visitData([this, &pointSizeScalars, pointSizeSourceDataset, numberOfPoints, begin](auto pointData) {
                 const auto currentDimensionIndex    = _sizeAction.getSourceAction().getDimensionPickerAction().getCurrentDimensionIndex();
                 const auto rangeMin                 = _sizeAction.getSourceAction().getRangeAction().getMinimum();
                 const auto rangeMax                 = _sizeAction.getSourceAction().getRangeAction().getMaximum();
                 const auto rangeLength              = rangeMax - rangeMin;
 
                 if (rangeLength > 0) {
-                    for (std::uint32_t pointIndex = 0; pointIndex < numberOfPoints; pointIndex++) {
+                    for (std::uint32_t pointIndex = begin; pointIndex < numberOfPoints; pointIndex++) {
                         auto pointValue = static_cast<float>(pointData[pointIndex][currentDimensionIndex]);
 
                         const auto pointValueClamped    = std::max(rangeMin, std::min(rangeMax, pointValue));
                         const auto pointValueNormalized = (pointValueClamped - rangeMin) / rangeLength;
 
-                        _pointSizeScalars[pointIndex] = _sizeAction.getSourceAction().getOffsetAction().getValue() + (pointValueNormalized * _sizeAction.getMagnitudeAction().getValue());
+                        pointSizeScalars[pointIndex] = _sizeAction.getSourceAction().getOffsetAction().getValue() + (pointValueNormalized * _sizeAction.getMagnitudeAction().getValue());
                     }
                 }
                 else {
-                    std::fill(_pointSizeScalars.begin(), _pointSizeScalars.end(), _sizeAction.getSourceAction().getOffsetAction().getValue() + (rangeMin * _sizeAction.getMagnitudeAction().getValue()));
+                    std::fill(pointSizeScalars.begin() + begin, pointSizeScalars.end(), _sizeAction.getSourceAction().getOffsetAction().getValue() + (rangeMin * _sizeAction.getMagnitudeAction().getValue()));
                 }
             });
         }
@@ -306,6 +327,11 @@ void PointPlotAction::updateScatterPlotWidgetPointSizeScalars()
 }
 
 void PointPlotAction::updateScatterPlotWidgetPointOpacityScalars()
+{
+    updatePointOpacityScalars(0);
+}
+
+void PointPlotAction::updatePointOpacityScalars(std::uint32_t begin)
 {
     if (_scatterplotPlugin == nullptr)
         return;
@@ -315,34 +341,42 @@ void PointPlotAction::updateScatterPlotWidgetPointOpacityScalars()
 
     const auto numberOfPoints = _scatterplotPlugin->getPositionDataset()->getNumPoints();
 
-    if (numberOfPoints != _pointOpacityScalars.size())
-        _pointOpacityScalars.resize(numberOfPoints);
+    begin = std::min(begin, numberOfPoints);
+
+    // Copy on write, as for the point size scalars
+    if (_pointOpacityScalars.use_count() > 1)
+        _pointOpacityScalars = std::make_shared<std::vector<float>>(*_pointOpacityScalars);
+
+    auto& pointOpacityScalars = *_pointOpacityScalars;
+
+    if (numberOfPoints != pointOpacityScalars.size())
+        pointOpacityScalars.resize(numberOfPoints);
 
     const auto opacityMagnitude = 0.01f * _opacityAction.getMagnitudeAction().getValue();
 
-    std::fill(_pointOpacityScalars.begin(), _pointOpacityScalars.end(), opacityMagnitude);
+    std::fill(pointOpacityScalars.begin() + begin, pointOpacityScalars.end(), opacityMagnitude);
 
     if (_opacityAction.isSourceSelection()) {
-        auto positionDataset    = _scatterplotPlugin->getPositionDataset();
-        auto selectionSet       = positionDataset->getSelection<Points>();
-
-        std::fill(_pointOpacityScalars.begin(), _pointOpacityScalars.end(), 0.01f * _opacityAction.getMagnitudeAction().getValue());
+        std::fill(pointOpacityScalars.begin() + begin, pointOpacityScalars.end(), 0.01f * _opacityAction.getMagnitudeAction().getValue());
 
         const auto opacityOffset                = 0.01f * _opacityAction.getSourceAction().getOffsetAction().getValue();
         const auto pointOpacitySelectedPoints   = std::min(1.0f, opacityMagnitude + opacityOffset);
 
-        std::vector<uint32_t> localSelectionIndices;
-        positionDataset->getLocalSelectionIndices(localSelectionIndices);
+        const auto& localSelection = _scatterplotPlugin->getLocalSelection();
 
-        for (const auto& selectionIndex : localSelectionIndices)
-            _pointOpacityScalars[selectionIndex] = pointOpacitySelectedPoints;
+        if (localSelection.getNumberOfPoints() == numberOfPoints) {
+            localSelection.forEachSelected([&pointOpacityScalars, pointOpacitySelectedPoints, begin](std::uint32_t localIndex) -> void {
+                if (localIndex >= begin)
+                    pointOpacityScalars[localIndex] = pointOpacitySelectedPoints;
+            });
+        }
     }
 
     if (_opacityAction.isSourceDataset()) {
         auto pointOpacitySourceDataset = Dataset<Points>(_opacityAction.getCurrentDataset());
 
         if (pointOpacitySourceDataset.isValid() && pointOpacitySourceDataset->getNumPoints() == _scatterplotPlugin->getPositionDataset()->getNumPoints()) {
-            pointOpacitySourceDataset->visitData([this, pointOpacitySourceDataset, numberOfPoints, opacityMagnitude](auto pointData) {
+            pointOpacitySourceDataset->visitData([this, &pointOpacityScalars, pointOpacitySourceDataset, numberOfPoints, begin, opacityMagnitude](auto pointData) {
                 const auto currentDimensionIndex    = _opacityAction.getSourceAction().getDimensionPickerAction().getCurrentDimensionIndex();
                 const auto opacityOffset            = 0.01f * _opacityAction.getSourceAction().getOffsetAction().getValue();
                 const auto rangeMin                 = _opacityAction.getSourceAction().getRangeAction().getMinimum();
@@ -350,24 +384,24 @@ void PointPlotAction::updateScatterPlotWidgetPointOpacityScalars()
                 const auto rangeLength              = rangeMax - rangeMin;
 
                 if (rangeLength > 0) {
-                    for (std::uint32_t pointIndex = 0; pointIndex < numberOfPoints; pointIndex++) {
+                    for (std::uint32_t pointIndex = begin; pointIndex < numberOfPoints; pointIndex++) {
                         auto pointValue                 = static_cast<float>(pointData[pointIndex][currentDimensionIndex]);
                         const auto pointValueClamped    = std::max(rangeMin, std::min(rangeMax, pointValue));
                         const auto pointValueNormalized = (pointValueClamped - rangeMin) / rangeLength;
 
                         if (opacityOffset == 1.0f)
-                            _pointOpacityScalars[pointIndex] = 1.0f;
+                            pointOpacityScalars[pointIndex] = 1.0f;
                         else
-                            _pointOpacityScalars[pointIndex] = opacityMagnitude * (opacityOffset + (pointValueNormalized / (1.0f - opacityOffset)));
+                            pointOpacityScalars[pointIndex] = opacityMagnitude * (opacityOffset + (pointValueNormalized / (1.0f - opacityOffset)));
                     }
                 }
                 else {
                     auto& rangeAction = _opacityAction.getSourceAction().getRangeAction();
 
                     if (rangeAction.getRangeMinAction().getValue() == rangeAction.getRangeMaxAction().getValue())
-                        std::fill(_pointOpacityScalars.begin(), _pointOpacityScalars.end(), 0.0f);
+                        std::fill(pointOpacityScalars.begin() + begin, pointOpacityScalars.end(), 0.0f);
                     else
-                        std::fill(_pointOpacityScalars.begin(), _pointOpacityScalars.end(), 1.0f);
+                        std::fill(pointOpacityScalars.begin() + begin, pointOpacityScalars.end(), 1.0f);
                 }
             });
         }
@@ -376,6 +410,13 @@ void PointPlotAction::updateScatterPlotWidgetPointOpacityScalars()
     _scatterplotPlugin->getScatterplotWidget().setPointOpacityScalars(_pointOpacityScalars);
 }
 
+void PointPlotAction::appendScatterPlotWidgetPointScalars(std::uint32_t previousNumberOfPoints)
+{
+    // Only the scalars of the appended points need to be computed when the cached scalars cover the previous points
+    updatePointSizeScalars(_pointSizeScalars->size() == previousNumberOfPoints ? previousNumberOfPoints : 0);
+    updatePointOpacityScalars(_pointOpacityScalars->size() == previousNumberOfPoints ? previousNumberOfPoints : 0);
+}
+
 void PointPlotAction::connectToPublicAction(WidgetAction* publicAction, bool recursive)
 {
     auto publicPointPlotAction = dynamic_cast<PointPlotAction*>(publicAction);
@@ -4,6 +4,9 @@
 
 #include "ScalarAction.h"
 
+#include <memory>
+#include <vector>
+
 class ScatterplotPlugin;
 
 using namespace mv::gui;
@@ -69,6 +72,24 @@ protected:
     /** Update the scatter plot widget point opacity scalars */
     void updateScatterPlotWidgetPointOpacityScalars();
 
+    /**
+     * Update the scatter plot widget point size and opacity scalars after points were appended to the position dataset
+     * @param previousNumberOfPoints Number of points before the append (the scalars of these points are kept)
+     */
+    void appendScatterPlotWidgetPointScalars(std::uint32_t previousNumberOfPoints);
+
+    /**
+     * Compute the point size scalars from local point index \p begin onwards and pass them to the scatter plot widget
+     * @param begin First local point index to compute the scalar for
+     */
+    void updatePointSizeScalars(std::uint32_t begin);
+
+    /**
+     * Compute the point opacity scalars from local point index \p begin onwards and pass them to the scatter plot widget
+     * @param begin First local point index to compute the scalar for
+     */
+    void updatePointOpacityScalars(std::uint32_t begin);
+
 protected: // Linking
 
     /**
@@ -108,8 +129,8 @@ private:
     ScatterplotPlugin*      _scatterplotPlugin;         /** Pointer to scatterplot plugin */
     ScalarAction            _sizeAction;                /** Point size action */
     ScalarAction            _opacityAction;             /** Point opacity action */
-    std::vector<float>      _pointSizeScalars;          /** Cached point size scalars */
-    std::vector<float>      _pointOpacityScalars;       /** Cached point opacity scalars */
+    std::shared_ptr<std::vector<float>>     _pointSizeScalars;      /** Cached point size scalars (shared with the widget while it aggregates them per cell) */
+    std::shared_ptr<std::vector<float>>     _pointOpacityScalars;   /** Cached point opacity scalars (shared with the widget while it aggregates them per cell) */
     ToggleAction            _focusSelection;            /** Focus selection action */
     std::int32_t            _lastOpacitySourceIndex;    /** Last opacity source index that was selected */
 
@@ -0,0 +1,272 @@
+#include "PositionBounds.h"
+#include "QuantileSketch.h"
+
+#include <QThread>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define POSITION_BOUNDS_SSE2
+#endif
+
+namespace {
+
+    /** Running extent of a range of points */
+    struct Extent {
+        float   minimumX = std::numeric_limits<float>::infinity();      /** Minimum x-coordinate */
+        float   maximumX = -std::numeric_limits<float>::infinity();     /** Maximum x-coordinate */
+        float   minimumY = std::numeric_limits<float>::infinity();      /** Minimum y-coordinate */
+        float   maximumY = -std::numeric_limits<float>::infinity();     /** Maximum y-coordinate */
+
+        /** Returns true when at least one point contributed */
+        bool isValid() const {
+            return minimumX <= maximumX;
+        }
+
+        /** Grow to include \p other */
+        void merge(const Extent& other) {
+            minimumX = std::min(minimumX, other.minimumX);
+            maximumX = std::max(maximumX, other.maximumX);
+            minimumY = std::min(minimumY, other.minimumY);
+            maximumY = std::max(maximumY, other.maximumY);
+        }
+    };
+
+    /** Reduce the points in [\p begin, \p end) of \p positions one at a time */
+    void reduceScalar(const PositionView& positions, std::uint32_t begin, std::uint32_t end, Extent& extent)
+    {
+        for (auto localIndex = begin; localIndex < end; localIndex++) {
+            const auto x = positions.getX(localIndex);
+            const auto y = positions.getY(localIndex);
+
+            if (!std::isfinite(x) || !std::isfinite(y))
+                continue;
+
+            extent.minimumX = std::min(extent.minimumX, x);
+            extent.maximumX = std::max(extent.maximumX, x);
+            extent.minimumY = std::min(extent.minimumY, y);
+            extent.maximumY = std::max(extent.maximumY, y);
+        }
+    }
+
+#ifdef POSITION_BOUNDS_SSE2
+
+    /** Reduce the points in [\p begin, \p end) of contiguous \p positions two at a time (lanes hold x0, y0, x1, y1) */
+    void reduceSse2(const PositionView& positions, std::uint32_t begin, std::uint32_t end, Extent& extent)
+    {
+        const auto data = positions.data();
+
+        const auto absoluteMask     = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+        const auto maximumFinite    = _mm_set1_ps(std::numeric_limits<float>::max());
+        const auto positiveInfinity = _mm_set1_ps(std::numeric_limits<float>::infinity());
+        const auto negativeInfinity = _mm_set1_ps(-std::numeric_limits<float>::infinity());
+
+        auto minimum = positiveInfinity;
+        auto maximum = negativeInfinity;
+
+        auto localIndex = begin;
+
+        for (; localIndex + 2 <= end; localIndex += 2) {
+            const auto xy = _mm_loadu_ps(data + 2 * static_cast<std::size_t>(localIndex));
+
+            // A lane is finite when its magnitude does not exceed the largest float (false for NaN and infinity), a point when both its lanes are
+            auto isFinite = _mm_cmple_ps(_mm_and_ps(xy, absoluteMask), maximumFinite);
+
+            isFinite = _mm_and_ps(isFinite, _mm_shuffle_ps(isFinite, isFinite, _MM_SHUFFLE(2, 3, 0, 1)));
+
+            // Replace the coordinates of skipped points by the identity of the reduction
+            minimum = _mm_min_ps(minimum, _mm_or_ps(_mm_and_ps(isFinite, xy), _mm_andnot_ps(isFinite, positiveInfinity)));
+            maximum = _mm_max_ps(maximum, _mm_or_ps(_mm_and_ps(isFinite, xy), _mm_andnot_ps(isFinite, negativeInfinity)));
+        }
+
+        float minimumLanes[4], maximumLanes[4];
+
+        _mm_storeu_ps(minimumLanes, minimum);
+        _mm_storeu_ps(maximumLanes, maximum);
+
+        Extent lanesExtent;
+
+        lanesExtent.minimumX = std::min(minimumLanes[0], minimumLanes[2]);
+        lanesExtent.maximumX = std::max(maximumLanes[0], maximumLanes[2]);
+        lanesExtent.minimumY = std::min(minimumLanes[1], minimumLanes[3]);
+        lanesExtent.maximumY = std::max(maximumLanes[1], maximumLanes[3]);
+
+        extent.merge(lanesExtent);
+
+        reduceScalar(positions, localIndex, end, extent);
+    }
+
+#endif
+
+    /** Reduce the points in [\p begin, \p end) of \p positions with the fastest available code path */
+    void reduce(const PositionView& positions, std::uint32_t begin, std::uint32_t end, Extent& extent)
+    {
+#ifdef POSITION_BOUNDS_SSE2
+        if (positions.isContiguous()) {
+            reduceSse2(positions, begin, end, extent);
+            return;
+        }
+#endif
+
+        reduceScalar(positions, begin, end, extent);
+    }
+
+    /** Inputs below this number of points are reduced on the calling thread */
+    constexpr std::uint32_t PARALLEL_THRESHOLD = 1 << 18;
+
+    /** Maximum number of points which are fed into the quantile sketches, the rank error of the sample is small compared to that of the sketches */
+    constexpr std::uint32_t ROBUST_BOUNDS_SAMPLES = 1 << 18;
+
+    /** Quantile sketches of the coordinates of a range of sampled points */
+    struct SketchChunk {
+        std::uint32_t   begin;          /** First sample index of the chunk */
+        std::uint32_t   end;            /** Sample index past the end of the chunk */
+        QuantileSketch  sketchX;        /** Sketch of the x-coordinates */
+        QuantileSketch  sketchY;        /** Sketch of the y-coordinates */
+    };
+
+    /** Feed the sampled points of \p sketchChunk, every \p stride-th point of \p positions, into its sketches */
+    void sketch(const PositionView& positions, std::uint32_t stride, SketchChunk& sketchChunk)
+    {
+        for (auto sampleIndex = sketchChunk.begin; sampleIndex < sketchChunk.end; sampleIndex++) {
+            const auto localIndex   = sampleIndex * stride;
+            const auto x            = positions.getX(localIndex);
+            const auto y            = positions.getY(localIndex);
+
+            if (!std::isfinite(x) || !std::isfinite(y))
+                continue;
+
+            sketchChunk.sketchX.add(x);
+            sketchChunk.sketchY.add(y);
+        }
+    }
+}
+
+namespace {
+
+    /** Get the extent of the points in \p positions with finite coordinates (in parallel chunks for large inputs) */
+    Extent getFiniteExtent(const PositionView& positions)
+    {
+        const auto numberOfPoints = positions.size();
+
+        Extent extent;
+
+        if (numberOfPoints < PARALLEL_THRESHOLD) {
+            reduce(positions, 0, numberOfPoints, extent);
+        }
+        else {
+            struct ExtentChunk {
+                std::uint32_t   begin;      /** First local point index of the chunk */
+                std::uint32_t   end;        /** Local point index past the end of the chunk */
+                Extent          extent;     /** Extent of the chunk */
+            };
+
+            const auto numberOfChunks   = static_cast<std::uint32_t>(std::max(1, 4 * QThread::idealThreadCount()));
+            const auto chunkSize        = std::max(1u, (numberOfPoints + numberOfChunks - 1) / numberOfChunks);
+
+            std::vector<ExtentChunk> extentChunks;
+
+            for (std::uint32_t chunkBegin = 0; chunkBegin < numberOfPoints; chunkBegin += chunkSize)
+                extentChunks.push_back({ chunkBegin, std::min(numberOfPoints, chunkBegin + chunkSize), {} });
+
+            QtConcurrent::blockingMap(extentChunks, [&positions](ExtentChunk& extentChunk) -> void {
+                reduce(positions, extentChunk.begin, extentChunk.end, extentChunk.extent);
+            });
+
+            for (const auto& extentChunk : extentChunks)
+                extent.merge(extentChunk.extent);
+        }
+
+        return extent;
+    }
+}
+
+namespace bounds {
+
+Bounds getFiniteBounds(const PositionView& positions)
+{
+    const auto extent = getFiniteExtent(positions);
+
+    if (!extent.isValid())
+        return Bounds();
+
+    Bounds bounds;
+
+    bounds.setLeft(extent.minimumX);
+    bounds.setRight(extent.maximumX);
+    bounds.setBottom(extent.minimumY);
+    bounds.setTop(extent.maximumY);
+
+    return bounds;
+}
+
+Bounds getRobustBounds(const PositionView& positions, float lowerQuantile, float upperQuantile)
+{
+    const auto numberOfPoints   = positions.size();
+    const auto stride           = std::max(1u, (numberOfPoints + ROBUST_BOUNDS_SAMPLES - 1) / ROBUST_BOUNDS_SAMPLES);
+    const auto numberOfSamples  = (numberOfPoints + stride - 1) / stride;
+
+    std::vector<SketchChunk> sketchChunks;
+
+    if (numberOfPoints < PARALLEL_THRESHOLD) {
+        sketchChunks.push_back({ 0, numberOfSamples, QuantileSketch(), QuantileSketch() });
+
+        sketch(positions, stride, sketchChunks.front());
+    }
+    else {
+        const auto numberOfChunks   = static_cast<std::uint32_t>(std::max(1, QThread::idealThreadCount()));
+        const auto chunkSize        = std::max(1u, (numberOfSamples + numberOfChunks - 1) / numberOfChunks);
+
+        for (std::uint32_t chunkBegin = 0; chunkBegin < numberOfSamples; chunkBegin += chunkSize)
+            sketchChunks.push_back({ chunkBegin, std::min(numberOfSamples, chunkBegin + chunkSize), QuantileSketch(), QuantileSketch() });
+
+        QtConcurrent::blockingMap(sketchChunks, [&positions, stride](SketchChunk& sketchChunk) -> void {
+            sketch(positions, stride, sketchChunk);
+        });
+    }
+
+    if (sketchChunks.empty())
+        return Bounds();
+
+    auto& sketchX = sketchChunks.front().sketchX;
+    auto& sketchY = sketchChunks.front().sketchY;
+
+    for (std::size_t chunkIndex = 1; chunkIndex < sketchChunks.size(); chunkIndex++) {
+        sketchX.merge(sketchChunks[chunkIndex].sketchX);
+        sketchY.merge(sketchChunks[chunkIndex].sketchY);
+    }
+
+    if (sketchX.isEmpty())
+        return Bounds();
+
+    Bounds bounds;
+
+    bounds.setLeft(sketchX.getQuantile(lowerQuantile));
+    bounds.setRight(sketchX.getQuantile(upperQuantile));
+    bounds.setBottom(sketchY.getQuantile(lowerQuantile));
+    bounds.setTop(sketchY.getQuantile(upperQuantile));
+
+    return bounds;
+}
+
+bool growFiniteBounds(const PositionView& positions, Bounds& bounds)
+{
+    const auto extent = getFiniteExtent(positions);
+
+    if (!extent.isValid())
+        return false;
+
+    bounds.setLeft(std::min(bounds.getLeft(), extent.minimumX));
+    bounds.setRight(std::max(bounds.getRight(), extent.maximumX));
+    bounds.setBottom(std::min(bounds.getBottom(), extent.minimumY));
+    bounds.setTop(std::max(bounds.getTop(), extent.maximumY));
+
+    return true;
+}
+
+}
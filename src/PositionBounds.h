@@ -0,0 +1,47 @@
+#pragma once
+
+#include "PositionView.h"
+
+#include "graphics/Bounds.h"
+
+using namespace mv;
+
+/**
+ * Position bounds helpers
+ *
+ * Compute the extent of point positions. Points with a NaN or infinite coordinate are
+ * skipped, so that they cannot poison the bounds. Large inputs are reduced in parallel
+ * chunks, and contiguous positions are reduced with SSE2 (scalar fallback otherwise).
+ * Robust bounds span quantiles of the coordinates instead, so that outliers do not
+ * stretch them.
+ */
+namespace bounds {
+
+/**
+ * Get the bounds of the points in \p positions with finite coordinates
+ * @param positions Point positions
+ * @return Bounds of the finite points (default bounds when there are none)
+ */
+Bounds getFiniteBounds(const PositionView& positions);
+
+/**
+ * Grow \p bounds to include the points in \p positions with finite coordinates
+ * @param positions Point positions
+ * @param bounds Bounds to grow (left untouched when none of the points is finite)
+ * @return Whether any of the points is finite
+ */
+bool growFiniteBounds(const PositionView& positions, Bounds& bounds);
+
+/**
+ * Get the bounds which span the \p lowerQuantile to \p upperQuantile range of each coordinate of the points in \p positions with finite coordinates
+ *
+ * Large inputs are sampled at a fixed stride; each parallel chunk feeds its sample into a pair of quantile sketches, which are merged afterwards.
+ *
+ * @param positions Point positions
+ * @param lowerQuantile Lower quantile in [0, 1] (e.g. 0.001)
+ * @param upperQuantile Upper quantile in [0, 1] (e.g. 0.999)
+ * @return Approximate quantile bounds (default bounds when none of the points is finite)
+ */
+Bounds getRobustBounds(const PositionView& positions, float lowerQuantile, float upperQuantile);
+
+}
@@ -0,0 +1,130 @@
+#include "PositionCache.h"
+
+#include <algorithm>
+#include <utility>
+
+PositionCache::PositionCache(std::size_t capacity) :
+    _capacity(capacity),
+    _size(0),
+    _compact(false),
+    _entries()
+{
+}
+
+void PositionCache::insert(const Key& key, const std::shared_ptr<const std::vector<Vector2f>>& positions, const Bounds& bounds, const Bounds& robustBounds, const std::shared_ptr<const PointGridIndex>& gridIndex)
+{
+    auto entry = std::find_if(_entries.begin(), _entries.end(), [&key](const Entry& entry) -> bool {
+        return entry.key == key;
+    });
+
+    if (entry != _entries.end()) {
+        _size -= getSize(*entry);
+        _entries.erase(entry);
+    }
+
+    if (!positions)
+        return;
+
+    const auto size = positions->size() * (_compact ? 2 * sizeof(std::uint16_t) : sizeof(Vector2f));
+
+    // Positions which do not fit at all are dropped instead of flushing the whole cache
+    if (!key.isValid() || size > _capacity)
+        return;
+
+    if (_compact) {
+        _entries.push_front({ key, nullptr, {}, bounds, robustBounds, nullptr });
+        _entries.front().quantizedPositions.quantize(PositionView(*positions), bounds);
+    }
+    else {
+        _entries.push_front({ key, positions, {}, bounds, robustBounds, gridIndex });
+    }
+
+    _size += getSize(_entries.front());
+
+    evict();
+}
+
+bool PositionCache::take(const Key& key, Entry& entry)
+{
+    auto cachedEntry = std::find_if(_entries.begin(), _entries.end(), [&key](const Entry& entry) -> bool {
+        return entry.key == key;
+    });
+
+    if (cachedEntry == _entries.end())
+        return false;
+
+    _size -= getSize(*cachedEntry);
+
+    entry = std::move(*cachedEntry);
+
+    _entries.erase(cachedEntry);
+
+    return true;
+}
+
+void PositionCache::remove(const QString& datasetId)
+{
+    for (auto entry = _entries.begin(); entry != _entries.end();) {
+        if (entry->key.datasetId != datasetId) {
+            ++entry;
+            continue;
+        }
+
+        _size -= getSize(*entry);
+        entry = _entries.erase(entry);
+    }
+}
+
+void PositionCache::clear()
+{
+    _entries.clear();
+    _size = 0;
+}
+
+bool PositionCache::isCompact() const
+{
+    return _compact;
+}
+
+void PositionCache::setCompact(bool compact)
+{
+    if (compact == _compact)
+        return;
+
+    _compact = compact;
+
+    clear();
+}
+
+float PositionCache::getMaximumQuantizationError() const
+{
+    auto maximumQuantizationError = 0.0f;
+
+    for (const auto& entry : _entries)
+        maximumQuantizationError = std::max(maximumQuantizationError, entry.quantizedPositions.getMaximumError());
+
+    return maximumQuantizationError;
+}
+
+std::size_t PositionCache::getSize() const
+{
+    return _size;
+}
+
+std::size_t PositionCache::getCapacity() const
+{
+    return _capacity;
+}
+
+std::size_t PositionCache::getSize(const Entry& entry)
+{
+    return (entry.positions ? entry.positions->size() * sizeof(Vector2f) : 0) + entry.quantizedPositions.getSizeInBytes() + (entry.gridIndex ? entry.gridIndex->getSizeInBytes() : 0);
+}
+
+void PositionCache::evict()
+{
+    while (_size > _capacity && !_entries.empty()) {
+        _size -= getSize(_entries.back());
+        _entries.pop_back();
+    }
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include "PointGridIndex.h"
+#include "QuantizedPositions.h"
+
+#include "graphics/Vector2f.h"
+#include "graphics/Bounds.h"
+
+#include <QString>
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <vector>
+
+using namespace mv;
+
+/**
+ * Position cache class
+ *
+ * Least recently used cache of extracted point positions (and their bounds and
+ * grid index) per dataset, data version and pair of dimensions. Positions and grid
+ * indices are shared immutable snapshots, so that flipping back to a recently used
+ * pair of dimensions neither extracts, copies nor indexes the positions. The total
+ * size of the cached positions is bounded, the least recently used entries are
+ * evicted first. In compact mode the positions are stored quantized to 16 bits per
+ * coordinate, which halves their size. Quantized positions are taken out as they
+ * are, so that they can be restored (and indexed again) on a worker thread.
+ */
+class PositionCache
+{
+public:
+
+    /** Identifies extracted positions */
+    struct Key {
+        QString         datasetId;          /** Globally unique identifier of the points dataset */
+        std::uint32_t   version = 0;        /** Version of the data of the points dataset */
+        std::int32_t    dimensionX = -1;    /** Index of the dimension used as x-coordinate */
+        std::int32_t    dimensionY = -1;    /** Index of the dimension used as y-coordinate */
+
+        /** Returns true when the key identifies positions */
+        bool isValid() const {
+            return !datasetId.isEmpty() && dimensionX >= 0 && dimensionY >= 0;
+        }
+
+        bool operator==(const Key& other) const {
+            return datasetId == other.datasetId && version == other.version && dimensionX == other.dimensionX && dimensionY == other.dimensionY;
+        }
+
+        bool operator!=(const Key& other) const {
+            return !(*this == other);
+        }
+    };
+
+    /** Cached positions */
+    struct Entry {
+        Key                                             key;                    /** Key of the positions */
+        std::shared_ptr<const std::vector<Vector2f>>    positions;              /** Point positions (not set when quantized) */
+        QuantizedPositions                              quantizedPositions;     /** Quantized point positions (in compact mode) */
+        Bounds                                          bounds;                 /** Bounds of the finite positions */
+        Bounds                                          robustBounds;           /** Bounds of the positions without the outliers */
+        std::shared_ptr<const PointGridIndex>           gridIndex;              /** Spatial index of the positions (not set when quantized) */
+    };
+
+public:
+
+    /**
+     * Construct with \p capacity
+     * @param capacity Maximum total size of the cached positions (in bytes)
+     */
+    explicit PositionCache(std::size_t capacity);
+
+    /**
+     * Cache \p positions with \p bounds, \p robustBounds and \p gridIndex under \p key (replaces an existing entry with the same key)
+     * @param key Key of the positions
+     * @param positions Point positions
+     * @param bounds Bounds of the finite positions
+     * @param robustBounds Bounds of the positions without the outliers
+     * @param gridIndex Spatial index of the positions (dropped in compact mode, it does not match the restored positions)
+     */
+    void insert(const Key& key, const std::shared_ptr<const std::vector<Vector2f>>& positions, const Bounds& bounds, const Bounds& robustBounds, const std::shared_ptr<const PointGridIndex>& gridIndex);
+
+    /**
+     * Take the entry cached under \p key out of the cache
+     * @param key Key of the positions
+     * @param entry Cached entry (output, only assigned on a hit, quantized positions are not restored)
+     * @return Whether the positions were cached
+     */
+    bool take(const Key& key, Entry& entry);
+
+    /**
+     * Remove all entries of the dataset with \p datasetId
+     * @param datasetId Globally unique identifier of the points dataset
+     */
+    void remove(const QString& datasetId);
+
+    /** Remove all entries */
+    void clear();
+
+    /** Get whether positions are stored quantized */
+    bool isCompact() const;
+
+    /**
+     * Set whether positions are stored quantized to \p compact (removes all entries when it changes)
+     * @param compact Whether to store positions quantized
+     */
+    void setCompact(bool compact);
+
+    /** Get the largest quantization error of the cached positions (in data space, zero when none are quantized) */
+    float getMaximumQuantizationError() const;
+
+    /** Get the total size of the cached positions (in bytes) */
+    std::size_t getSize() const;
+
+    /** Get the maximum total size of the cached positions (in bytes) */
+    std::size_t getCapacity() const;
+
+protected:
+
+    /** Get the size of the positions and grid index in \p entry (in bytes) */
+    static std::size_t getSize(const Entry& entry);
+
+    /** Evict least recently used entries until the cached positions fit in the capacity */
+    void evict();
+
+private:
+    std::size_t         _capacity;      /** Maximum total size of the cached positions (in bytes) */
+    std::size_t         _size;          /** Total size of the cached positions (in bytes) */
+    bool                _compact;       /** Whether positions are stored quantized */
+    std::list<Entry>    _entries;       /** Cached entries, most recently used first */
+};
@@ -0,0 +1,57 @@
+#include "PositionView.h"
+
+#include <cstring>
+
+static_assert(sizeof(Vector2f) == 2 * sizeof(float), "Vector2f must consist of two packed floats");
+
+PositionView::PositionView() :
+    _x(nullptr),
+    _y(nullptr),
+    _stride(2),
+    _numberOfPoints(0)
+{
+}
+
+PositionView::PositionView(const std::vector<Vector2f>& positions) :
+    _x(positions.empty() ? nullptr : &positions.front().x),
+    _y(positions.empty() ? nullptr : &positions.front().y),
+    _stride(2),
+    _numberOfPoints(static_cast<std::uint32_t>(positions.size()))
+{
+}
+
+PositionView::PositionView(const float* data, std::uint32_t numberOfPoints, std::uint32_t numberOfDimensions, std::uint32_t dimensionX, std::uint32_t dimensionY) :
+    _x(data + dimensionX),
+    _y(data + dimensionY),
+    _stride(numberOfDimensions),
+    _numberOfPoints(numberOfPoints)
+{
+}
+
+bool PositionView::isContiguous() const
+{
+    return _stride == 2 && _y == _x + 1;
+}
+
+void PositionView::copyTo(std::vector<Vector2f>& positions) const
+{
+    positions.resize(_numberOfPoints);
+
+    copyTo(positions.data());
+}
+
+void PositionView::copyTo(Vector2f* positions) const
+{
+    if (_numberOfPoints == 0)
+        return;
+
+    if (isContiguous()) {
+        std::memcpy(static_cast<void*>(positions), _x, static_cast<std::size_t>(_numberOfPoints) * sizeof(Vector2f));
+        return;
+    }
+
+    for (std::uint32_t localIndex = 0; localIndex < _numberOfPoints; localIndex++) {
+        positions[localIndex].x = getX(localIndex);
+        positions[localIndex].y = getY(localIndex);
+    }
+}
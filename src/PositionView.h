@@ -0,0 +1,93 @@
+#pragma once
+
+#include "graphics/Vector2f.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using namespace mv;
+
+/**
+ * Position view class
+ *
+ * Non-owning, strided view of two-dimensional point positions. It either references
+ * two columns of interleaved (row-major) dataset storage or a vector of positions.
+ * Dataset storage is only viewed on the GUI thread while columns are gathered from
+ * it, everything else views the gathered positions. The referenced storage must
+ * outlive the view and must not be reallocated.
+ */
+class PositionView
+{
+public:
+
+    /** Default constructor (empty view) */
+    PositionView();
+
+    /**
+     * Construct a view of \p positions
+     * @param positions Point positions
+     */
+    explicit PositionView(const std::vector<Vector2f>& positions);
+
+    /**
+     * Construct a view of dimensions \p dimensionX and \p dimensionY of row-major \p data
+     * @param data Pointer to the first element of the data
+     * @param numberOfPoints Number of points (rows)
+     * @param numberOfDimensions Number of dimensions (columns)
+     * @param dimensionX Index of the dimension to use as x-coordinate
+     * @param dimensionY Index of the dimension to use as y-coordinate
+     */
+    PositionView(const float* data, std::uint32_t numberOfPoints, std::uint32_t numberOfDimensions, std::uint32_t dimensionX, std::uint32_t dimensionY);
+
+    /** Get the number of points */
+    std::uint32_t size() const {
+        return _numberOfPoints;
+    }
+
+    /** Returns true when the view holds no points */
+    bool empty() const {
+        return _numberOfPoints == 0;
+    }
+
+    /** Get the x-coordinate of the point with \p localIndex */
+    float getX(std::uint32_t localIndex) const {
+        return _x[static_cast<std::size_t>(localIndex) * _stride];
+    }
+
+    /** Get the y-coordinate of the point with \p localIndex */
+    float getY(std::uint32_t localIndex) const {
+        return _y[static_cast<std::size_t>(localIndex) * _stride];
+    }
+
+    /** Get the position of the point with \p localIndex */
+    Vector2f operator[](std::uint32_t localIndex) const {
+        return Vector2f(getX(localIndex), getY(localIndex));
+    }
+
+    /** Get pointer to the x-coordinate of the first point (consecutive x, y pairs from here on when the view is contiguous) */
+    const float* data() const {
+        return _x;
+    }
+
+    /** Returns true when the x- and y-coordinates are stored as consecutive pairs (same layout as a vector of positions) */
+    bool isContiguous() const;
+
+    /**
+     * Copy the positions to \p positions (a single memory copy when the view is contiguous)
+     * @param positions Point positions (output, resized to the number of points)
+     */
+    void copyTo(std::vector<Vector2f>& positions) const;
+
+    /**
+     * Copy the positions to the array starting at \p positions
+     * @param positions Pointer to room for the positions (output, at least the number of points)
+     */
+    void copyTo(Vector2f* positions) const;
+
+private:
+    const float*    _x;                 /** Pointer to the x-coordinate of the first point */
+    const float*    _y;                 /** Pointer to the y-coordinate of the first point */
+    std::size_t     _stride;            /** Number of floats between consecutive points */
+    std::uint32_t   _numberOfPoints;    /** Number of points */
+};
@@ -0,0 +1,127 @@
+#include "QuantileSketch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+QuantileSketch::QuantileSketch(std::uint32_t k) :
+    _k(std::max(k, MINIMUM_CAPACITY)),
+    _count(0),
+    _compactors(),
+    _keepOdd(),
+    _capacities()
+{
+    addLevel();
+}
+
+void QuantileSketch::add(float value)
+{
+    _compactors.front().push_back(value);
+
+    _count++;
+
+    if (_compactors.front().size() >= _capacities.front())
+        compress();
+}
+
+void QuantileSketch::merge(const QuantileSketch& other)
+{
+    while (_compactors.size() < other._compactors.size())
+        addLevel();
+
+    for (std::size_t level = 0; level < other._compactors.size(); level++)
+        _compactors[level].insert(_compactors[level].end(), other._compactors[level].begin(), other._compactors[level].end());
+
+    _count += other._count;
+
+    compress();
+}
+
+std::uint64_t QuantileSketch::getCount() const
+{
+    return _count;
+}
+
+bool QuantileSketch::isEmpty() const
+{
+    return _count == 0;
+}
+
+float QuantileSketch::getQuantile(float quantile) const
+{
+    if (isEmpty())
+        return std::numeric_limits<float>::quiet_NaN();
+
+    // Weighted values in ascending order
+    std::vector<std::pair<float, std::uint64_t>> weightedValues;
+
+    std::uint64_t totalWeight = 0;
+
+    for (std::size_t level = 0; level < _compactors.size(); level++) {
+        const auto weight = std::uint64_t(1) << level;
+
+        for (const auto value : _compactors[level])
+            weightedValues.emplace_back(value, weight);
+
+        totalWeight += weight * _compactors[level].size();
+    }
+
+    std::sort(weightedValues.begin(), weightedValues.end());
+
+    const auto rank = static_cast<double>(std::clamp(quantile, 0.0f, 1.0f)) * totalWeight;
+
+    std::uint64_t cumulativeWeight = 0;
+
+    for (const auto& weightedValue : weightedValues) {
+        cumulativeWeight += weightedValue.second;
+
+        if (cumulativeWeight >= rank)
+            return weightedValue.first;
+    }
+
+    return weightedValues.back().first;
+}
+
+void QuantileSketch::addLevel()
+{
+    _compactors.emplace_back();
+    _keepOdd.push_back(false);
+
+    // Capacities decay geometrically (by two thirds) from the highest level down
+    _capacities.resize(_compactors.size());
+
+    for (std::size_t level = 0; level < _compactors.size(); level++) {
+        const auto depth = static_cast<double>(_compactors.size() - 1 - level);
+
+        _capacities[level] = std::max(MINIMUM_CAPACITY, static_cast<std::uint32_t>(std::ceil(_k * std::pow(2.0 / 3.0, depth))));
+    }
+}
+
+void QuantileSketch::compress()
+{
+    for (std::uint32_t level = 0; level < _compactors.size(); level++) {
+        if (_compactors[level].size() < _capacities[level])
+            continue;
+
+        if (level + 1 == _compactors.size())
+            addLevel();
+
+        auto& compactor = _compactors[level];
+
+        std::sort(compactor.begin(), compactor.end());
+
+        // An odd value out stays behind
+        const auto numberOfPairs    = compactor.size() / 2;
+        const auto offset           = _keepOdd[level] ? 1 : 0;
+
+        auto& nextCompactor = _compactors[level + 1];
+
+        for (std::size_t pairIndex = 0; pairIndex < numberOfPairs; pairIndex++)
+            nextCompactor.push_back(compactor[2 * pairIndex + offset]);
+
+        compactor.erase(compactor.begin(), compactor.begin() + 2 * numberOfPairs);
+
+        _keepOdd[level] = !_keepOdd[level];
+    }
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * Quantile sketch class
+ *
+ * Mergeable streaming quantile sketch after Karnin, Lang and Liberty (KLL). Values are
+ * buffered in a hierarchy of compactors; a full compactor is sorted and every other
+ * value is promoted to the next level with twice the weight. Compactors alternate
+ * between keeping the even and odd values instead of flipping a coin, so that the same
+ * input always yields the same quantiles. The rank error is in the order of 1 / \p k.
+ */
+class QuantileSketch
+{
+public:
+
+    /**
+     * Construct with accuracy parameter \p k
+     * @param k Capacity of the highest compactor (larger is more accurate)
+     */
+    explicit QuantileSketch(std::uint32_t k = DEFAULT_K);
+
+    /**
+     * Add \p value to the sketch
+     * @param value Value (NaN is not supported)
+     */
+    void add(float value);
+
+    /**
+     * Merge \p other into this sketch, the result approximates the quantiles of the values of both
+     * @param other Other sketch (should have the same accuracy parameter)
+     */
+    void merge(const QuantileSketch& other);
+
+    /** Get the number of values which were added (including those of merged sketches) */
+    std::uint64_t getCount() const;
+
+    /** Returns true when no values were added */
+    bool isEmpty() const;
+
+    /**
+     * Get the approximate value at \p quantile
+     * @param quantile Quantile in [0, 1]
+     * @return Value at the quantile (NaN when the sketch is empty)
+     */
+    float getQuantile(float quantile) const;
+
+private:
+
+    /** Add a compactor on top and update the capacities of all compactors */
+    void addLevel();
+
+    /** Compact the compactors which exceed their capacity */
+    void compress();
+
+private:
+    std::uint32_t                       _k;                 /** Capacity of the highest compactor */
+    std::uint64_t                       _count;             /** Number of values which were added */
+    std::vector<std::vector<float>>     _compactors;        /** Buffered values per level (the weight of a value doubles per level) */
+    std::vector<bool>                   _keepOdd;           /** Whether the next compaction of a level keeps the odd values */
+    std::vector<std::uint32_t>          _capacities;        /** Capacity per compactor */
+
+public:
+    static constexpr std::uint32_t DEFAULT_K        = 2048;     /** Default accuracy parameter */
+    static constexpr std::uint32_t MINIMUM_CAPACITY = 64;         /** Minimum capacity of a compactor */
+};
@@ -0,0 +1,101 @@
+#include "QuantizedPositions.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+QuantizedPositions::QuantizedPositions() :
+    _minimumX(0.0f),
+    _minimumY(0.0f),
+    _stepX(0.0f),
+    _stepY(0.0f),
+    _coordinates(),
+    _maximumError(0.0f)
+{
+}
+
+void QuantizedPositions::quantize(const PositionView& positions, const Bounds& bounds)
+{
+    const auto numberOfPoints = positions.size();
+
+    _minimumX       = bounds.getLeft();
+    _minimumY       = bounds.getBottom();
+    _stepX          = std::max(0.0f, bounds.getWidth()) / MAXIMUM_LEVEL;
+    _stepY          = std::max(0.0f, bounds.getHeight()) / MAXIMUM_LEVEL;
+    _maximumError   = 0.0f;
+
+    _coordinates.resize(2 * static_cast<std::size_t>(numberOfPoints));
+
+    for (std::uint32_t localIndex = 0; localIndex < numberOfPoints; localIndex++) {
+        const auto x = positions.getX(localIndex);
+        const auto y = positions.getY(localIndex);
+
+        const auto levelX = quantize(x, _minimumX, _stepX);
+        const auto levelY = quantize(y, _minimumY, _stepY);
+
+        _coordinates[2 * static_cast<std::size_t>(localIndex)]      = levelX;
+        _coordinates[2 * static_cast<std::size_t>(localIndex) + 1]  = levelY;
+
+        if (levelX != NON_FINITE_LEVEL)
+            _maximumError = std::max(_maximumError, std::abs(dequantize(levelX, _minimumX, _stepX) - x));
+
+        if (levelY != NON_FINITE_LEVEL)
+            _maximumError = std::max(_maximumError, std::abs(dequantize(levelY, _minimumY, _stepY) - y));
+    }
+}
+
+void QuantizedPositions::dequantize(std::vector<Vector2f>& positions) const
+{
+    const auto numberOfPoints = size();
+
+    positions.resize(numberOfPoints);
+
+    for (std::uint32_t localIndex = 0; localIndex < numberOfPoints; localIndex++) {
+        positions[localIndex].x = dequantize(_coordinates[2 * static_cast<std::size_t>(localIndex)], _minimumX, _stepX);
+        positions[localIndex].y = dequantize(_coordinates[2 * static_cast<std::size_t>(localIndex) + 1], _minimumY, _stepY);
+    }
+}
+
+void QuantizedPositions::clear()
+{
+    _coordinates.clear();
+    _coordinates.shrink_to_fit();
+
+    _maximumError = 0.0f;
+}
+
+std::uint32_t QuantizedPositions::size() const
+{
+    return static_cast<std::uint32_t>(_coordinates.size() / 2);
+}
+
+std::size_t QuantizedPositions::getSizeInBytes() const
+{
+    return _coordinates.capacity() * sizeof(std::uint16_t);
+}
+
+float QuantizedPositions::getMaximumError() const
+{
+    return _maximumError;
+}
+
+std::uint16_t QuantizedPositions::quantize(float value, float minimum, float step)
+{
+    if (!std::isfinite(value))
+        return NON_FINITE_LEVEL;
+
+    if (step <= 0.0f)
+        return 0;
+
+    const auto level = std::round((value - minimum) / step);
+
+    return static_cast<std::uint16_t>(std::clamp(level, 0.0f, static_cast<float>(MAXIMUM_LEVEL)));
+}
+
+float QuantizedPositions::dequantize(std::uint16_t level, float minimum, float step)
+{
+    if (level == NON_FINITE_LEVEL)
+        return std::numeric_limits<float>::quiet_NaN();
+
+    return minimum + level * step;
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "PositionView.h"
+
+#include "graphics/Vector2f.h"
+#include "graphics/Bounds.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using namespace mv;
+
+/**
+ * Quantized positions class
+ *
+ * Compact copy of point positions which stores each coordinate as a 16-bit unsigned
+ * normalized value relative to the bounds of the positions (half the size of float
+ * positions). Non-finite coordinates are kept as a reserved value and restored as NaN.
+ * The largest deviation from the float positions is measured during quantization.
+ */
+class QuantizedPositions
+{
+public:
+
+    /** Default constructor */
+    QuantizedPositions();
+
+    /**
+     * Quantize \p positions relative to \p bounds
+     * @param positions Point positions
+     * @param bounds Bounds of the finite positions (finite coordinates outside are clamped)
+     */
+    void quantize(const PositionView& positions, const Bounds& bounds);
+
+    /**
+     * Restore the positions
+     * @param positions Point positions (output, resized to the number of points)
+     */
+    void dequantize(std::vector<Vector2f>& positions) const;
+
+    /** Release the quantized positions */
+    void clear();
+
+    /** Get the number of points */
+    std::uint32_t size() const;
+
+    /** Get the size of the quantized positions (in bytes) */
+    std::size_t getSizeInBytes() const;
+
+    /** Get the largest distance along either axis between a restored and an original finite coordinate (in data space) */
+    float getMaximumError() const;
+
+private:
+
+    /**
+     * Quantize \p value in the range starting at \p minimum with \p step
+     * @param value Coordinate
+     * @param minimum Lower end of the range
+     * @param step Size of a quantization step (zero for an empty range)
+     * @return Quantized coordinate
+     */
+    static std::uint16_t quantize(float value, float minimum, float step);
+
+    /**
+     * Restore \p level in the range starting at \p minimum with \p step
+     * @param level Quantized coordinate
+     * @param minimum Lower end of the range
+     * @param step Size of a quantization step
+     * @return Coordinate
+     */
+    static float dequantize(std::uint16_t level, float minimum, float step);
+
+private:
+    float                       _minimumX;      /** Lower end of the x-coordinate range */
+    float                       _minimumY;      /** Lower end of the y-coordinate range */
+    float                       _stepX;         /** Size of an x-coordinate quantization step */
+    float                       _stepY;         /** Size of a y-coordinate quantization step */
+    std::vector<std::uint16_t>  _coordinates;   /** Interleaved quantized x- and y-coordinates */
+    float                       _maximumError;  /** Largest deviation of a restored finite coordinate */
+
+    static constexpr std::uint16_t MAXIMUM_LEVEL    = 0xFFFE;   /** Quantized value of the upper end of the range */
+    static constexpr std::uint16_t NON_FINITE_LEVEL = 0xFFFF;   /** Quantized value of non-finite coordinates */
+};
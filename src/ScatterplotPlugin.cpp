@@ -6,6 +6,11 @@
 #include "util/PixelSelectionTool.h"
 #include "util/Timer.h"
 
+#include "PositionBounds.h"
+#include "SelectionMask.h"
+#include "SelectionMerge.h"
+#include "SelectionPolygon.h"
+
 #include "PointData/PointData.h"
 #include "ClusterData/ClusterData.h"
 #include "ColorData/ColorData.h"
@@ -21,14 +26,24 @@
 #include <QtCore>
 #include <QApplication>
 #include <QDebug>
+#include <QLoggingCategory>
 #include <QMenu>
 #include <QAction>
 #include <QMetaType>
+#include <QStandardPaths>
+#include <QtConcurrent>
+#include <QToolTip>
+#include <QUuid>
 
 #include <algorithm>
+#include <cstring>
 #include <functional>
+#include <iterator>
 #include <limits>
+#include <memory>
+#include <numeric>
 #include <set>
+#include <type_traits>
 #include <vector>
 
 Q_PLUGIN_METADATA(IID "nl.tudelft.SimianScatterplotPlugin")
@@ -36,18 +51,55 @@ Q_PLUGIN_METADATA(IID "nl.tudelft.SimianScatterplotPlugin")
 using namespace mv;
 using namespace mv::util;
 
+// Performance statistics, off by default (enable with QT_LOGGING_RULES="scatterplot.performance.debug=true")
+Q_LOGGING_CATEGORY(performanceLog, "scatterplot.performance", QtInfoMsg)
+
 ScatterplotPlugin::ScatterplotPlugin(const PluginFactory* factory) :
     ViewPlugin(factory),
     _positionDataset(),
     _positionSourceDataset(),
-    _positions(),
+    _positions(std::make_shared<const std::vector<mv::Vector2f>>()),
+    _positionCache(POSITION_CACHE_CAPACITY),
+    _positionsKey(),
+    _positionsBounds(),
+    _positionsRobustBounds(),
+    _positionsVersion(0),
+    _mappedFileCache(QDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation)).filePath("ScatterplotPlugin"), PERSISTENT_CACHE_CAPACITY),
+    _positionsGather(),
+    _positionsGatherTimer(),
+    _positionsWatcher(),
+    _requestedPositionsKey(),
+    _pointGridIndex(std::make_shared<const PointGridIndex>()),
+    _pointGridPyramid(),
+    _pointGridPyramidWatcher(),
+    _selectionStroke(),
+    _selectionStrokeId(0),
+    _selectionWatcher(),
+    _selectionCancelled(false),
+    _selectionGeneration(0),
+    _pendingSelectionRequest(),
+    _hasPendingSelectionRequest(false),
+    _clickPosition(),
+    _clickSelectionStrokeId(std::numeric_limits<std::uint32_t>::max()),
+    _globalIndexTable(std::make_shared<const GlobalIndexTable>()),
+    _localSelection(),
+    _highlightedSelection(),
+    _highlights(),
+    _selectionEcho(),
+    _hoverClusterIndices(),
+    _hoverClusterNames(),
+    _hoverScalarsDataset(),
+    _hoverScalarsDimension(0),
+    _hoverScalarsDimensionName(),
     _numPoints(0),
     _scatterPlotWidget(new ScatterplotWidget()),
    // _dropWidget(nullptr),
     _settingsAction(this, "Settings"),
     _primaryToolbarAction(this, "Primary Toolbar"),
     _secondaryToolbarAction(this, "Secondary Toolbar"),
-    _selectPointsTimer(),
+    _selectionScheduler(this),
+    _updateFlags(),
+    _updateTimer(),
     _selectedCrossSpeciesCluster(this, "CrossSpeciesclusterSelection"),
     _scatterplotColorControlAction(this, "Scatterplot Expression color control")
 {
@@ -208,23 +260,15 @@ ScatterplotPlugin::ScatterplotPlugin(const PluginFactory* factory) :
 
     //    return dropRegions;
     //});
-
-    /*
-    _selectPointsTimer.setSingleShot(true);
-
-    connect(&_selectPointsTimer, &QTimer::timeout, this, [this]() -> void {
-        if (_selectPointsTimer.isActive())
-            _selectPointsTimer.start(LAZY_UPDATE_INTERVAL);
-        else {
-            _selectPointsTimer.stop();
-            selectPoints();
-        }
-    });
-    */
 }
 
 ScatterplotPlugin::~ScatterplotPlugin()
 {
+    cancelSelectionComputation();
+
+    // The workers reference the plugin (the selection computation its cancel flag, the extraction the persistent cache)
+    _selectionWatcher.waitForFinished();
+    _positionsWatcher.waitForFinished();
 }
 
 void ScatterplotPlugin::init()
@@ -289,25 +333,130 @@ void ScatterplotPlugin::init()
     // Update the data when the scatter plot widget is initialized
     connect(_scatterPlotWidget, &ScatterplotWidget::initialized, this, &ScatterplotPlugin::updateData);
 
-    // Update the selection when the pixel selection tool selected area changed
+    // Dirty parts are flushed together once control returns to the event loop
+    _updateTimer.setSingleShot(true);
+    _updateTimer.setInterval(0);
+
+    connect(&_updateTimer, &QTimer::timeout, this, &ScatterplotPlugin::flushUpdates);
+
+    auto& updateIntervalAction = _settingsAction.getSelectionAction().getUpdateIntervalAction();
+
+    _selectionScheduler.setInterval(updateIntervalAction.getValue());
+
+    connect(&updateIntervalAction, &IntegralAction::valueChanged, this, [this](std::int32_t value) {
+        _selectionScheduler.setInterval(value);
+    });
+
+    auto& compactPositionCacheAction = _settingsAction.getMiscellaneousAction().getCompactPositionCacheAction();
+
+    _positionCache.setCompact(compactPositionCacheAction.isChecked());
+
+    connect(&compactPositionCacheAction, &ToggleAction::toggled, this, [this](bool toggled) {
+        _positionCache.setCompact(toggled);
+    });
+
+    connect(&_settingsAction.getMiscellaneousAction().getLevelOfDetailAction(), &ToggleAction::toggled, this, &ScatterplotPlugin::updatePointGridPyramid);
+    connect(&_settingsAction.getMiscellaneousAction().getRobustBoundsAction(), &ToggleAction::toggled, this, &ScatterplotPlugin::reuploadPositions);
+
+    // The point attributes which the renderer holds do not line up with the drawn points or cells anymore
+    connect(_scatterPlotWidget, &ScatterplotWidget::aggregationChanged, this, [this]() {
+        requestUpdate(PointSize | PointOpacity | Colors | Highlights);
+    });
+
+    connect(&_pointGridPyramidWatcher, &QFutureWatcher<PointGridPyramidFrame>::finished, this, &ScatterplotPlugin::pointGridPyramidBuilt);
+
+    // Show information about the point under the cursor
+    connect(_scatterPlotWidget, &ScatterplotWidget::mouseHovered, this, &ScatterplotPlugin::showHoverTooltip);
+
+    // Large datasets are gathered in slices, so that the GUI keeps responding in between
+    _positionsGatherTimer.setSingleShot(true);
+    _positionsGatherTimer.setInterval(0);
+
+    connect(&_positionsGatherTimer, &QTimer::timeout, this, &ScatterplotPlugin::gatherPositions);
+
+    // Swap in the extracted positions on the GUI thread when the extraction finished
+    connect(&_positionsWatcher, &QFutureWatcher<PositionFrame>::finished, this, &ScatterplotPlugin::positionsExtracted);
+
+    // Apply the selection on the GUI thread when the computation finished
+    connect(&_selectionWatcher, &QFutureWatcher<SelectionResult>::finished, this, &ScatterplotPlugin::selectionComputed);
+
+    // Select points when the scheduler decides that it is time for an update
+    connect(&_selectionScheduler, &SelectionScheduler::triggered, this, &ScatterplotPlugin::selectPoints);
+
+    // Request a (rate limited) selection update when the pixel selection tool selected area changed
     connect(&_scatterPlotWidget->getPixelSelectionTool(), &PixelSelectionTool::areaChanged, [this]() {
-        if (_scatterPlotWidget->getPixelSelectionTool().isNotifyDuringSelection()) {
-            //_selectPointsTimer.start(LAZY_UPDATE_INTERVAL);
-            selectPoints();
-        }
+        auto& pixelSelectionTool = _scatterPlotWidget->getPixelSelectionTool();
+
+        if (!pixelSelectionTool.isNotifyDuringSelection())
+            return;
+
+        // A press might still turn out to be a click, so hold back until the cursor is dragged
+        if (_settingsAction.getSelectionAction().getClickSelectionAction().isChecked() && pixelSelectionTool.getType() != PixelSelectionType::Polygon && !_scatterPlotWidget->isMouseDragged())
+            return;
+
+        _selectionScheduler.schedule();
+    });
+
+    // Remember clicks, the pixel selection tool ends the stroke right after the click
+    connect(_scatterPlotWidget, &ScatterplotWidget::mouseClicked, this, [this](const QPointF& widgetPosition) {
+        _clickPosition          = widgetPosition;
+        _clickSelectionStrokeId = _selectionStrokeId;
     });
 
     // Update the selection when the pixel selection process ended
     connect(&_scatterPlotWidget->getPixelSelectionTool(), &PixelSelectionTool::ended, [this]() {
-        if (_scatterPlotWidget->getPixelSelectionTool().isNotifyDuringSelection())
-            return;
+        auto& pixelSelectionTool = _scatterPlotWidget->getPixelSelectionTool();
+
+        const auto isClick = _settingsAction.getSelectionAction().getClickSelectionAction().isChecked() && _clickSelectionStrokeId == _selectionStrokeId && !pixelSelectionTool.isAborted() && pixelSelectionTool.getType() != PixelSelectionType::Polygon;
+
+        // Select the point(s) under the cursor on a click, otherwise always deliver the final state of the selection
+        if (isClick) {
+            _selectionScheduler.cancel();
+            selectClickedPoints(_clickPosition);
+        }
+        else if (pixelSelectionTool.isNotifyDuringSelection()) {
+            _selectionScheduler.flush();
+        }
+        else {
+            selectPoints();
+        }
 
-        //_selectPointsTimer.start(LAZY_UPDATE_INTERVAL);
-        selectPoints();
+        if (_selectionScheduler.getNumberOfCoalescedUpdates() > 0 || _selectionScheduler.getNumberOfDroppedUpdates() > 0)
+            qCDebug(performanceLog) << "Selection updates coalesced:" << _selectionScheduler.getNumberOfCoalescedUpdates() << "dropped:" << _selectionScheduler.getNumberOfDroppedUpdates();
+
+        _selectionScheduler.resetStatistics();
+
+        // The next selection stroke starts from scratch
+        _selectionStrokeId++;
+    });
+
+    // The global index table is only invalidated when the points change, it is rebuilt on first use
+    connect(&_positionDataset, &Dataset<Points>::changed, this, [this]() {
+        cancelSelectionComputation();
+        _globalIndexTable = std::make_shared<const GlobalIndexTable>();
+
+        // Only positions of the current position dataset are cached
+        _positionCache.clear();
+    });
+
+    connect(&_positionDataset, &Dataset<Points>::dataChanged, this, [this]() {
+        cancelSelectionComputation();
+        _globalIndexTable = std::make_shared<const GlobalIndexTable>();
+
+        // Positions which were extracted from the previous data are of no use anymore (the drawn ones may still be appended to)
+        _positionsVersion++;
+
+        _settingsAction.getMiscellaneousAction().getDataVersionTokenAction().setString(QString());
+        _settingsAction.getMiscellaneousAction().getDataVersionTokenDatasetIdAction().setString(QString());
+
+        if (_positionDataset.isValid())
+            _positionCache.remove(_positionDataset->getId());
     });
 
     connect(&_positionDataset, &Dataset<Points>::changed, this, &ScatterplotPlugin::positionDatasetChanged);
-    connect(&_positionDataset, &Dataset<Points>::dataChanged, this, &ScatterplotPlugin::updateData);
+    connect(&_positionDataset, &Dataset<Points>::dataChanged, this, [this]() {
+        requestUpdate(Positions);
+    });
     connect(&_positionDataset, &Dataset<Points>::dataSelectionChanged, this, &ScatterplotPlugin::updateSelection);
     // Update the window title when the GUI name of the position dataset changes
     connect(&_positionDataset, &Dataset<Points>::guiNameChanged, this, &ScatterplotPlugin::updateWindowTitle);
@@ -350,90 +499,387 @@ void ScatterplotPlugin::createSubset(const bool& fromSourceData /*= false*/, con
 void ScatterplotPlugin::selectPoints()
 {
     // Only proceed with a valid points position dataset and when the pixel selection tool is active
-    if (!_positionDataset.isValid() || !_scatterPlotWidget->getPixelSelectionTool().isActive())
+    if (!_positionDataset.isValid() || !_scatterPlotWidget->getPixelSelectionTool().isActive() || !hasCurrentPositions())
         return;
 
     //qDebug() << _positionDataset->getGuiName() << "selectPoints";
 
-    // Get binary selection area image from the pixel selection tool
-    auto selectionAreaImage = _scatterPlotWidget->getPixelSelectionTool().getAreaPixmap().toImage();
+    auto& pixelSelectionTool = _scatterPlotWidget->getPixelSelectionTool();
 
-    // Get smart pointer to the position selection dataset
-    auto selectionSet = _positionDataset->getSelection<Points>();
+    const auto selectionType            = pixelSelectionTool.getType();
+    const auto hasDataSpaceSelection    = selectionType == PixelSelectionType::Rectangle || selectionType == PixelSelectionType::Lasso || selectionType == PixelSelectionType::Polygon;
 
-    // Create vector for target selection indices
-    std::vector<std::uint32_t> targetSelectionIndices;
+    // Snapshot everything the computation needs from the GUI thread, the worker does not touch the widget or the datasets
+    SelectionRequest selectionRequest;
 
-    // Reserve space for the indices
-    targetSelectionIndices.reserve(_positionDataset->getNumPoints());
+    selectionRequest.strokeId           = _selectionStrokeId;
+    selectionRequest.isExact            = _settingsAction.getSelectionAction().getExactSelectionAction().isChecked() && hasDataSpaceSelection;
+    selectionRequest.isRectangle        = selectionType == PixelSelectionType::Rectangle;
+    selectionRequest.areaImage          = selectionRequest.isExact ? QImage() : pixelSelectionTool.getAreaPixmap().toImage();
+    selectionRequest.bounds             = _scatterPlotWidget->getBounds();
+    selectionRequest.selectionShape     = selectionRequest.isExact ? _scatterPlotWidget->getSelectionShape() : std::vector<Vector2f>();
+
+    // Selection should be subtracted when the selection process was aborted by the user (e.g. by pressing the escape key)
+    selectionRequest.modifier           = pixelSelectionTool.isAborted() ? PixelSelectionModifierType::Subtract : pixelSelectionTool.getModifier();
+
+    submitSelectionRequest(std::move(selectionRequest));
+}
+
+void ScatterplotPlugin::selectClickedPoints(const QPointF& widgetPosition)
+{
+    if (!_positionDataset.isValid() || !hasCurrentPositions())
+        return;
+
+    auto& pixelSelectionTool = _scatterPlotWidget->getPixelSelectionTool();
+
+    const auto dataPosition = _scatterPlotWidget->getDataPosition(widgetPosition);
+
+    SelectionRequest selectionRequest;
+
+    selectionRequest.strokeId       = _selectionStrokeId;
+    selectionRequest.isClick        = true;
+    selectionRequest.clickPosition  = dataPosition;
+    selectionRequest.clickRadius    = _scatterPlotWidget->getDataPosition(widgetPosition + QPointF(_settingsAction.getSelectionAction().getClickRadiusAction().getValue(), 0.0)).x - dataPosition.x;
+    selectionRequest.pickRadius     = _scatterPlotWidget->getDataPosition(widgetPosition + QPointF(PICK_RADIUS, 0.0)).x - dataPosition.x;
+
+    // Like a drag selection, an aborted click subtracts from the selection instead of adding to it
+    selectionRequest.modifier       = pixelSelectionTool.isAborted() ? PixelSelectionModifierType::Subtract : pixelSelectionTool.getModifier();
+
+    submitSelectionRequest(std::move(selectionRequest));
+}
+
+void ScatterplotPlugin::submitSelectionRequest(SelectionRequest&& selectionRequest)
+{
+    // A newer request supersedes the one which is waiting for the computation in flight
+    if (_selectionWatcher.isRunning()) {
+        _pendingSelectionRequest    = std::move(selectionRequest);
+        _hasPendingSelectionRequest = true;
+
+        return;
+    }
+
+    startSelectionComputation(std::move(selectionRequest));
+}
+
+void ScatterplotPlugin::startSelectionComputation(SelectionRequest&& selectionRequest)
+{
+    // Requests of the same stroke continue from the hit test state of the previous request
+    if (!_selectionStroke || _selectionStroke->id != selectionRequest.strokeId) {
+        _selectionStroke        = std::make_shared<SelectionStroke>();
+        _selectionStroke->id    = selectionRequest.strokeId;
+    }
+
+    // The add and subtract modifiers apply to the selection before the stroke, it is copied once per stroke instead of per request
+    if (selectionRequest.modifier != PixelSelectionModifierType::Replace && !_selectionStroke->selectionIndices && _positionDataset.isValid()) {
+        auto selectionIndices = _positionDataset->getSelection<Points>()->indices;
+
+        selection::makeSorted(selectionIndices);
+
+        _selectionStroke->selectionIndices = std::make_shared<const std::vector<std::uint32_t>>(std::move(selectionIndices));
+    }
+
+    // Make sure the global index table is built before the worker reads it
+    getGlobalIndexTable();
+
+    // The worker only reads snapshots, so the positions and indices can be swapped while it is in flight
+    selectionRequest.positions          = _positions;
+    selectionRequest.gridIndex          = _pointGridIndex;
+    selectionRequest.globalIndexTable   = _globalIndexTable;
+    selectionRequest.selectionStroke    = _selectionStroke;
+
+    _selectionCancelled = false;
+
+    const auto generation = _selectionGeneration;
+
+    _selectionWatcher.setFuture(QtConcurrent::run([this, selectionRequest = std::move(selectionRequest), generation]() -> SelectionResult {
+        auto selectionResult = computeSelection(selectionRequest);
+
+        selectionResult.generation = generation;
+
+        return selectionResult;
+    }));
+}
+
+void ScatterplotPlugin::cancelSelectionComputation()
+{
+    _hasPendingSelectionRequest = false;
+    _pendingSelectionRequest    = SelectionRequest();
+    _selectionCancelled         = true;
+    _selectionGeneration++;
+
+    // The computation only reads snapshots, so it may finish in the background: its result is of an older generation and is discarded
+}
+
+void ScatterplotPlugin::selectionComputed()
+{
+    auto selectionResult = _selectionWatcher.result();
+
+    // Apply the result unless it was cancelled or computed for data which changed since
+    if (!selectionResult.cancelled && selectionResult.generation == _selectionGeneration && _positionDataset.isValid()) {
+
+        _positionDataset->setSelectionIndices(selectionResult.selectionIndices);
+
+        // Remember what was selected, so that the selection change which echoes back to this view can be recognized
+        _selectionEcho.pending  = true;
+        _selectionEcho.indices  = std::move(selectionResult.selectionIndices);
+
+        // The local selection was already computed along with the result
+        _localSelection = std::move(selectionResult.localSelection);
+
+        updateHighlights();
+
+        emit localSelectionChanged();
+
+        events().notifyDatasetDataSelectionChanged(_positionDataset->getSourceDataset<Points>());
+    }
+
+    // Start the computation of the latest request which arrived in the meantime
+    if (_hasPendingSelectionRequest) {
+        _hasPendingSelectionRequest = false;
+
+        startSelectionComputation(std::move(_pendingSelectionRequest));
+    }
+}
+
+ScatterplotPlugin::SelectionResult ScatterplotPlugin::computeSelection(const SelectionRequest& selectionRequest)
+{
+    SelectionResult selectionResult;
+
+    // Snapshots of the data as drawn when the computation started
+    const PositionView positionView(*selectionRequest.positions);
+
+    const auto& pointGridIndex      = *selectionRequest.gridIndex;
+    const auto& globalIndexTable    = *selectionRequest.globalIndexTable;
+    auto& selectionStroke           = *selectionRequest.selectionStroke;
 
     // Mapping from local to global indices
-    std::vector<std::uint32_t> localGlobalIndices;
+    const auto& localGlobalIndices = globalIndexTable.getGlobalIndices();
+
+    // Hit test the non-empty grid cells which overlap with a region in parallel (per row of cells), each cell is processed by one thread so the writes never overlap
+    const auto hitTestGridCells = [this, &pointGridIndex](const Bounds& region, const std::function<void(std::uint32_t, std::uint32_t)>& hitTestGridCell) -> void {
+        std::uint32_t columnMin = 0, columnMax = 0, rowMin = 0, rowMax = 0;
+
+        if (!pointGridIndex.getCellRange(region, columnMin, columnMax, rowMin, rowMax))
+            return;
+
+        std::vector<std::uint32_t> rows(rowMax - rowMin + 1);
+
+        std::iota(rows.begin(), rows.end(), rowMin);
+
+        QtConcurrent::blockingMap(rows, [this, &pointGridIndex, columnMin, columnMax, &hitTestGridCell](const std::uint32_t& row) -> void {
+            if (_selectionCancelled)
+                return;
+
+            for (std::uint32_t column = columnMin; column <= columnMax; column++)
+                if (pointGridIndex.getNumberOfPointsInCell(pointGridIndex.getCellIndex(column, row)) > 0)
+                    hitTestGridCell(column, row);
+        });
+    };
+
+    // Gather the local indices of the hits in per-thread chunks, which are concatenated in chunk order so that the result is in point order
+    const auto gatherHits = [](const std::vector<std::uint8_t>& hits, std::vector<std::uint32_t>& hitIndices) -> void {
+        struct HitsChunk {
+            std::uint32_t               begin;      /** First local point index of the chunk */
+            std::uint32_t               end;        /** Local point index past the end of the chunk */
+            std::vector<std::uint32_t>  indices;    /** Local indices of the hits in the chunk */
+        };
 
-    // Get global indices from the position dataset
-    _positionDataset->getGlobalIndices(localGlobalIndices);
+        const auto numberOfPoints   = static_cast<std::uint32_t>(hits.size());
+        const auto numberOfChunks   = static_cast<std::uint32_t>(std::max(1, 4 * QThread::idealThreadCount()));
+        const auto chunkSize        = std::max(1u, (numberOfPoints + numberOfChunks - 1) / numberOfChunks);
 
-    const auto dataBounds = _scatterPlotWidget->getBounds();
-    const auto width = selectionAreaImage.width();
-    const auto height = selectionAreaImage.height();
-    const auto size = width < height ? width : height;
+        std::vector<HitsChunk> hitsChunks;
 
-    // Loop over all points and establish whether they are selected or not
-    for (std::uint32_t i = 0; i < _positions.size(); i++) {
-        const auto uvNormalized = QPointF((_positions[i].x - dataBounds.getLeft()) / dataBounds.getWidth(), (dataBounds.getTop() - _positions[i].y) / dataBounds.getHeight());
-        const auto uvOffset     = QPoint((selectionAreaImage.width() - size) / 2.0f, (selectionAreaImage.height() - size) / 2.0f);
-        const auto uv           = uvOffset + QPoint(uvNormalized.x() * size, uvNormalized.y() * size);
+        for (std::uint32_t chunkBegin = 0; chunkBegin < numberOfPoints; chunkBegin += chunkSize)
+            hitsChunks.push_back({ chunkBegin, std::min(numberOfPoints, chunkBegin + chunkSize), {} });
 
-        // Add point if the corresponding pixel selection is on
-        if (selectionAreaImage.pixelColor(uv).alpha() > 0)
-            targetSelectionIndices.push_back(localGlobalIndices[i]);
+        QtConcurrent::blockingMap(hitsChunks, [&hits](HitsChunk& hitsChunk) -> void {
+            for (auto localIndex = hitsChunk.begin; localIndex < hitsChunk.end; localIndex++)
+                if (hits[localIndex])
+                    hitsChunk.indices.push_back(localIndex);
+        });
+
+        std::size_t numberOfHits = 0;
+
+        for (const auto& hitsChunk : hitsChunks)
+            numberOfHits += hitsChunk.indices.size();
+
+        hitIndices.clear();
+        hitIndices.reserve(numberOfHits);
+
+        for (const auto& hitsChunk : hitsChunks)
+            hitIndices.insert(hitIndices.end(), hitsChunk.indices.begin(), hitsChunk.indices.end());
+    };
+
+    // Sorted local indices of the points inside the selection area
+    std::vector<std::uint32_t> hitIndices;
+
+    if (selectionRequest.isClick) {
+
+        // Query the grid index around the click instead of hit testing a selection area
+        if (selectionRequest.clickRadius > 0.0f) {
+            hitIndices = pointGridIndex.findWithinRadius(positionView, selectionRequest.clickPosition, selectionRequest.clickRadius);
+        }
+        else {
+            std::uint32_t nearestIndex = 0;
+
+            if (pointGridIndex.findNearest(positionView, selectionRequest.clickPosition, selectionRequest.pickRadius, nearestIndex))
+                hitIndices.push_back(nearestIndex);
+        }
     }
+    else if (selectionRequest.isExact) {
 
-    // Selection should be subtracted when the selection process was aborted by the user (e.g. by pressing the escape key)
-    const auto selectionModifier = _scatterPlotWidget->getPixelSelectionTool().isAborted() ? PixelSelectionModifierType::Subtract : _scatterPlotWidget->getPixelSelectionTool().getModifier();
+        // Hit flag per local point index
+        std::vector<std::uint8_t> hits(positionView.size(), 0);
+
+        // Test the points against the exact selection shape in data space, no rasterization involved
+        const SelectionPolygon selectionPolygon(selectionRequest.selectionShape, selectionRequest.isRectangle);
+
+        if (selectionPolygon.isValid()) {
+            hitTestGridCells(selectionPolygon.getBounds(), [&pointGridIndex, &positionView, &selectionPolygon, &hits](std::uint32_t column, std::uint32_t row) -> void {
+                const auto cellIndex = pointGridIndex.getCellIndex(column, row);
+
+                // Accept the whole cell when it lies inside the selection rectangle
+                if (selectionPolygon.containsBounds(pointGridIndex.getCellBounds(column, row))) {
+                    for (auto pointIndex = pointGridIndex.cellBegin(cellIndex); pointIndex != pointGridIndex.cellEnd(cellIndex); ++pointIndex)
+                        hits[*pointIndex] = 1;
+
+                    return;
+                }
+
+                selectionPolygon.contains(positionView, pointGridIndex.cellBegin(cellIndex), pointGridIndex.cellEnd(cellIndex), hits.data());
+            });
+        }
+
+        if (_selectionCancelled) {
+            selectionResult.cancelled = true;
+            return selectionResult;
+        }
+
+        gatherHits(hits, hitIndices);
+    }
+    else {
+
+        // Convert the binary selection area image of the pixel selection tool once into a mask which supports fast lookups
+        auto selectionMask = std::make_shared<const SelectionMask>(selectionRequest.areaImage, selectionRequest.bounds);
+
+        // Within a selection stroke, only the pixels which changed since the previous update need to be hit tested again
+        const auto isIncremental = selectionStroke.selectionMask != nullptr && selectionStroke.selectionMask->isCompatible(*selectionMask) && selectionStroke.hits.size() == positionView.size();
+
+        if (!isIncremental) {
+            selectionStroke.hits.assign(positionView.size(), 0);
+            selectionStroke.hitIndices.clear();
+        }
+
+        const auto hitTestRect = isIncremental ? selectionMask->getDifferenceRect(*selectionStroke.selectionMask) : selectionMask->getBoundingRect();
+
+        // Local indices of the points which entered or left the selection area (only tracked for incremental updates), per row of grid cells
+        std::vector<std::vector<std::uint32_t>> entered(isIncremental ? pointGridIndex.getResolution() : 0);
+        std::vector<std::vector<std::uint32_t>> left(isIncremental ? pointGridIndex.getResolution() : 0);
+
+        auto& hits = selectionStroke.hits;
+
+        // Only visit the grid cells which overlap with the bounding box of the (changed) selection area
+        if (!hitTestRect.isEmpty()) {
+            hitTestGridCells(selectionMask->getBounds(hitTestRect), [&pointGridIndex, &positionView, &selectionMask, &hits, &entered, &left, isIncremental](std::uint32_t column, std::uint32_t row) -> void {
+                const auto cellIndex = pointGridIndex.getCellIndex(column, row);
+
+                const auto setHit = [&hits, &entered, &left, isIncremental, row](std::uint32_t pointIndex, std::uint8_t hit) -> void {
+                    if (hits[pointIndex] == hit)
+                        return;
+
+                    hits[pointIndex] = hit;
+
+                    if (isIncremental)
+                        (hit ? entered : left)[row].push_back(pointIndex);
+                };
+
+                // Pixel rectangle which contains all points in the cell
+                const auto cellRect                 = selectionMask->getPixelRect(pointGridIndex.getCellBounds(column, row));
+                const auto numberOfSelectedPixels   = selectionMask->getNumberOfSelectedPixels(cellRect);
+                const auto isCellSelected           = QRect(0, 0, selectionMask->getWidth(), selectionMask->getHeight()).contains(cellRect) && numberOfSelectedPixels == static_cast<std::uint32_t>(cellRect.width() * cellRect.height());
+
+                // Reject or accept the whole cell when none or all of its pixels are selected
+                if (numberOfSelectedPixels == 0 || isCellSelected) {
+                    for (auto pointIndex = pointGridIndex.cellBegin(cellIndex); pointIndex != pointGridIndex.cellEnd(cellIndex); ++pointIndex)
+                        setHit(*pointIndex, isCellSelected ? 1 : 0);
+
+                    return;
+                }
+
+                // Test the points in partially selected cells individually
+                for (auto pointIndex = pointGridIndex.cellBegin(cellIndex); pointIndex != pointGridIndex.cellEnd(cellIndex); ++pointIndex)
+                    setHit(*pointIndex, selectionMask->containsPosition(positionView.getX(*pointIndex), positionView.getY(*pointIndex)) ? 1 : 0);
+            });
+        }
+
+        // The hit flags are only partially updated, so the next request needs a full pass
+        if (_selectionCancelled) {
+            selectionStroke.selectionMask = nullptr;
+
+            selectionResult.cancelled = true;
+            return selectionResult;
+        }
+
+        if (isIncremental) {
+
+            // Merge the points which entered and left the selection area into the running hits of the stroke
+            const auto flatten = [](const std::vector<std::vector<std::uint32_t>>& indicesPerRow) -> std::vector<std::uint32_t> {
+                std::vector<std::uint32_t> indices;
+
+                for (const auto& rowIndices : indicesPerRow)
+                    indices.insert(indices.end(), rowIndices.begin(), rowIndices.end());
+
+                std::sort(indices.begin(), indices.end());
+
+                return indices;
+            };
+
+            const auto enteredIndices   = flatten(entered);
+            const auto leftIndices      = flatten(left);
+
+            selectionStroke.hitIndices = selection::subtract(selection::unite(selectionStroke.hitIndices, enteredIndices), leftIndices);
+        }
+        else {
+            gatherHits(hits, selectionStroke.hitIndices);
+        }
+
+        selectionStroke.selectionMask = selectionMask;
+
+        hitIndices = selectionStroke.hitIndices;
+    }
+
+    // Create vector for target selection indices
+    auto& targetSelectionIndices = selectionResult.selectionIndices;
+
+    // Reserve space for the indices
+    targetSelectionIndices.reserve(hitIndices.size());
 
-    switch (selectionModifier)
+    for (const auto& hitIndex : hitIndices)
+        targetSelectionIndices.push_back(localGlobalIndices[hitIndex]);
+
+    switch (selectionRequest.modifier)
     {
         case PixelSelectionModifierType::Replace:
             break;
 
+        // Add points to the selection before the stroke
         case PixelSelectionModifierType::Add:
-        case PixelSelectionModifierType::Subtract:
         {
-            // Get reference to the indices of the selection set
-            auto& selectionSetIndices = selectionSet->indices;
-
-            // Create a set from the selection set indices
-            QSet<std::uint32_t> set(selectionSetIndices.begin(), selectionSetIndices.end());
-
-            switch (selectionModifier)
-            {
-                // Add points to the current selection
-            case PixelSelectionModifierType::Add:
-            {
-                // Add indices to the set 
-                for (const auto& targetIndex : targetSelectionIndices)
-                    set.insert(targetIndex);
-
-                break;
-            }
+            selection::makeSorted(targetSelectionIndices);
 
-            // Remove points from the current selection
-            case PixelSelectionModifierType::Subtract:
-            {
-                // Remove indices from the set 
-                for (const auto& targetIndex : targetSelectionIndices)
-                    set.remove(targetIndex);
+            if (selectionStroke.selectionIndices)
+                targetSelectionIndices = selection::unite(*selectionStroke.selectionIndices, targetSelectionIndices);
 
-                break;
-            }
+            break;
+        }
 
-            default:
-                break;
-            }
+        // Remove points from the selection before the stroke
+        case PixelSelectionModifierType::Subtract:
+        {
+            selection::makeSorted(targetSelectionIndices);
 
-            // Convert set back to vector
-            targetSelectionIndices = std::vector<std::uint32_t>(set.begin(), set.end());
+            targetSelectionIndices = selectionStroke.selectionIndices ? selection::subtract(*selectionStroke.selectionIndices, targetSelectionIndices) : std::vector<std::uint32_t>();
 
             break;
         }
@@ -442,9 +888,21 @@ void ScatterplotPlugin::selectPoints()
             break;
     }
 
-    _positionDataset->setSelectionIndices(targetSelectionIndices);
+    // Resolve the local selection here as well, so that the GUI thread does not need to when the result is applied
+    std::vector<std::uint32_t> localSelectionIndices;
+
+    localSelectionIndices.reserve(targetSelectionIndices.size());
+
+    for (const auto& globalIndex : targetSelectionIndices) {
+        const auto localIndex = globalIndexTable.getLocalIndex(globalIndex);
+
+        if (localIndex != GlobalIndexTable::INVALID_INDEX)
+            localSelectionIndices.push_back(localIndex);
+    }
+
+    selectionResult.localSelection.assign(static_cast<std::uint32_t>(localGlobalIndices.size()), localSelectionIndices);
 
-    events().notifyDatasetDataSelectionChanged(_positionDataset->getSourceDataset<Points>());
+    return selectionResult;
 }
 
 void ScatterplotPlugin::updateWindowTitle()
@@ -477,13 +935,13 @@ void ScatterplotPlugin::positionDatasetChanged()
     //if (_positionDataset->isDerivedData())
     _positionSourceDataset = _positionDataset->getSourceDataset<Points>();
 
-    _numPoints = _positionDataset->getNumPoints();
+    // The number of points is updated when the positions of the dataset are swapped in, so that the point attributes are updated along with them
 
     //_scatterPlotWidget->getPixelSelectionTool().setEnabled(_positionDataset.isValid());
     _scatterPlotWidget->getPixelSelectionTool().setEnabled(false);
    // _dropWidget->setShowDropIndicator(!_positionDataset.isValid());
 
-    updateData();
+    requestUpdate(Positions);
     // Update the window title to reflect the position dataset change
     updateWindowTitle();
 }
@@ -507,8 +965,15 @@ void ScatterplotPlugin::loadColors(const Dataset<Points>& points, const std::uin
     if (dimensionIndex >= 0)
         points->extractDataForDimension(scalars, dimensionIndex);
 
+    // The hover tooltip reads the value of the hovered point from the dataset
+    const auto dimensionNames = points->getDimensionNames();
+
+    _hoverScalarsDataset        = points;
+    _hoverScalarsDimension      = dimensionIndex;
+    _hoverScalarsDimensionName  = dimensionIndex < static_cast<std::uint32_t>(dimensionNames.size()) ? dimensionNames[dimensionIndex] : QString("Value");
+
     // Assign scalars and scalar effect
-    _scatterPlotWidget->setScalars(scalars);
+    _scatterPlotWidget->setScalars(std::make_shared<const std::vector<float>>(std::move(scalars)));
     _scatterPlotWidget->setScalarEffect(PointEffect::Color);
     _scene.clear();
     _settingsAction.getColoringAction().updateColorMapActionScalarRange();
@@ -523,40 +988,104 @@ void ScatterplotPlugin::loadColors(const Dataset<Clusters>& clusters)
     if (!clusters.isValid() || !_positionDataset.isValid())
         return;
 
-    // Mapping from local to global indices
-    std::vector<std::uint32_t> globalIndices;
+    const auto& globalIndexTable = getGlobalIndexTable();
 
-    // Get global indices from the position dataset
-    int totalNumPoints = 0;
-    if (_positionDataset->isDerivedData())
-        totalNumPoints = _positionSourceDataset->getFullDataset<Points>()->getNumPoints();
-    else
-        totalNumPoints = _positionDataset->getFullDataset<Points>()->getNumPoints();
+    // Generate color buffer for local colors
+    std::vector<Vector3f> localColors(_positions->size());
 
-    _positionDataset->getGlobalIndices(globalIndices);
+    // Cluster per point for the hover tooltip
+    _hoverClusterIndices.assign(_positions->size(), -1);
+    _hoverClusterNames.clear();
+    _hoverScalarsDataset.reset();
 
-    // Generate color buffer for global and local colors
-    std::vector<Vector3f> globalColors(totalNumPoints);
-    std::vector<Vector3f> localColors(_positions.size());
+    // Loop over all clusters and populate the colors of the points which are part of the position dataset
+    for (const auto& cluster : clusters->getClusters()) {
+        const auto clusterColor = Vector3f(cluster.getColor().redF(), cluster.getColor().greenF(), cluster.getColor().blueF());
+        const auto clusterIndex = static_cast<std::int32_t>(_hoverClusterNames.count());
 
-    // Loop over all clusters and populate global colors
-    for (const auto& cluster : clusters->getClusters())
-        for (const auto& index : cluster.getIndices())
-            globalColors[index] = Vector3f(cluster.getColor().redF(), cluster.getColor().greenF(), cluster.getColor().blueF());
-    std::int32_t localColorIndex = 0;
+        _hoverClusterNames << cluster.getName();
+
+        for (const auto& globalIndex : cluster.getIndices()) {
+            const auto localIndex = globalIndexTable.getLocalIndex(globalIndex);
+
+            if (localIndex >= localColors.size())
+                continue;
+
+            localColors[localIndex]             = clusterColor;
+            _hoverClusterIndices[localIndex]    = clusterIndex;
+        }
+    }
 
-    // Loop over all global indices and find the corresponding local color
-    for (const auto& globalIndex : globalIndices)
-        localColors[localColorIndex++] = globalColors[globalIndex];
     _scene.clear();
     updateLegend(clusters);
     // Apply colors to scatter plot widget without modification
-    _scatterPlotWidget->setColors(localColors);
+    _scatterPlotWidget->setColors(std::make_shared<const std::vector<Vector3f>>(std::move(localColors)));
 
     // Render
     getWidget().update();
 }
 
+void ScatterplotPlugin::showHoverTooltip(const QPointF& widgetPosition)
+{
+    if (!_positionDataset.isValid() || !_pointGridIndex->isValid() || !hasCurrentPositions()) {
+        QToolTip::hideText();
+        return;
+    }
+
+    // Convert the hover radius from pixels to data space
+    const auto dataPosition = _scatterPlotWidget->getDataPosition(widgetPosition);
+    const auto dataRadius   = _scatterPlotWidget->getDataPosition(widgetPosition + QPointF(PICK_RADIUS, 0.0)).x - dataPosition.x;
+
+    std::uint32_t localIndex = 0;
+
+    if (!_pointGridIndex->findNearest(PositionView(*_positions), dataPosition, dataRadius, localIndex)) {
+        QToolTip::hideText();
+        return;
+    }
+
+    const auto& globalIndices = getGlobalIndexTable().getGlobalIndices();
+
+    QStringList lines;
+
+    lines << QString("Point: %1").arg(localIndex < globalIndices.size() ? globalIndices[localIndex] : localIndex);
+
+    if (_hoverClusterIndices.size() == _positions->size() && _hoverClusterIndices[localIndex] >= 0)
+        lines << QString("Cluster: %1").arg(_hoverClusterNames[_hoverClusterIndices[localIndex]]);
+
+    // Only when the points are still colored by the dataset
+    if (_hoverScalarsDataset.isValid() && _scatterPlotWidget->getColoringMode() == ScatterplotWidget::ColoringMode::Data && _hoverScalarsDataset->getNumPoints() == _positions->size() && _hoverScalarsDimension < _hoverScalarsDataset->getNumDimensions()) {
+        float value = 0.0f;
+
+        _hoverScalarsDataset->visitData([this, localIndex, &value](auto pointData) {
+            value = static_cast<float>(pointData[localIndex][_hoverScalarsDimension]);
+        });
+
+        lines << QString("%1: %2").arg(_hoverScalarsDimensionName, QString::number(value));
+    }
+
+    // The tooltip hides as soon as the cursor leaves the neighbourhood of the point
+    const auto hoverRect = QRect(widgetPosition.toPoint() - QPoint(PICK_RADIUS, PICK_RADIUS), QSize(2 * PICK_RADIUS, 2 * PICK_RADIUS));
+
+    QToolTip::showText(_scatterPlotWidget->mapToGlobal(widgetPosition.toPoint()), lines.join("\n"), _scatterPlotWidget, hoverRect);
+}
+
+const GlobalIndexTable& ScatterplotPlugin::getGlobalIndexTable()
+{
+    if (!_globalIndexTable->isValid() && _positionDataset.isValid()) {
+        std::vector<std::uint32_t> localGlobalIndices;
+
+        _positionDataset->getGlobalIndices(localGlobalIndices);
+
+        auto globalIndexTable = std::make_shared<GlobalIndexTable>();
+
+        globalIndexTable->build(std::move(localGlobalIndices));
+
+        _globalIndexTable = std::move(globalIndexTable);
+    }
+
+    return *_globalIndexTable;
+}
+
 ScatterplotWidget& ScatterplotPlugin::getScatterplotWidget()
 {
     return *_scatterPlotWidget;
@@ -692,33 +1221,540 @@ void ScatterplotPlugin::updateData()
         if (xDim < 0 || yDim < 0)
             return;
 
-        // Ensure that if positionDataset has now more points, the additional points are plotted
-        if (_numPoints != _positionDataset->getNumPoints())
-        {
-            _settingsAction.getPlotAction().getPointPlotAction().updateScatterPlotWidgetPointSizeScalars();
-            _settingsAction.getPlotAction().getPointPlotAction().updateScatterPlotWidgetPointOpacityScalars();
-        }
+        const PositionCache::Key positionsKey{ _positionDataset->getId(), _positionsVersion, xDim, yDim };
 
-        // Determine number of points depending on if its a full dataset or a subset
-        _numPoints = _positionDataset->getNumPoints();
+        // Results of in-flight extractions for other positions are parked in the cache
+        _requestedPositionsKey = positionsKey;
 
-        // Extract 2-dimensional points from the data set based on the selected dimensions
-        calculatePositions(*_positionDataset);
+        // Streaming producers append points to the dataset, only the appended points need to be extracted then
+        if (updateAppendedPositions(positionsKey))
+            return;
 
-        // Pass the 2D points to the scatter plot widget
-        _scatterPlotWidget->setData(&_positions);
+        PositionFrame positionFrame;
 
-        updateSelection();
-    }
+        positionFrame.key = positionsKey;
+
+        // Re-use the current positions
+        if (positionsKey == _positionsKey) {
+            positionFrame.positions         = _positions;
+            positionFrame.bounds            = _positionsBounds;
+            positionFrame.robustBounds      = _positionsRobustBounds;
+            positionFrame.gridIndex         = _pointGridIndex;
+            positionFrame.pointGridPyramid  = _pointGridPyramid;
+
+            applyPositionFrame(std::move(positionFrame));
+            return;
+        }
+
+        // The scatter plot widget keeps drawing the current positions until the extraction finished, which requests these positions again
+        if (isExtractingPositions())
+            return;
+
+        PositionCache::Entry cacheEntry;
+
+        // Only extract the positions on a cache miss
+        if (!_positionCache.take(positionsKey, cacheEntry)) {
+            startPositionsExtraction(positionsKey);
+            return;
+        }
+
+        // Quantized positions are restored and indexed in the background, the others are cached along with their grid index
+        if (!cacheEntry.positions || !cacheEntry.gridIndex) {
+            startPositionsIndexing(std::move(cacheEntry));
+            return;
+        }
+
+        positionFrame.positions     = std::move(cacheEntry.positions);
+        positionFrame.bounds        = cacheEntry.bounds;
+        positionFrame.robustBounds  = cacheEntry.robustBounds;
+        positionFrame.gridIndex     = std::move(cacheEntry.gridIndex);
+
+        applyPositionFrame(std::move(positionFrame));
+    }
     else {
-        _positions.clear();
-        _scatterPlotWidget->setData(&_positions);
+        _requestedPositionsKey = PositionCache::Key();
+
+        _selectionScheduler.cancel();
+        cancelSelectionComputation();
+
+        _positionsKey = PositionCache::Key();
+
+        _positions          = std::make_shared<const std::vector<Vector2f>>();
+        _pointGridIndex     = std::make_shared<const PointGridIndex>();
+        _pointGridPyramid.reset();
+        _selectionStroke.reset();
+        _localSelection.reset(0);
+        _scatterPlotWidget->setData(_positions);
+    }
+}
+
+void ScatterplotPlugin::startPositionsExtraction(const PositionCache::Key& positionsKey, bool isPersistentCacheAllowed /*= true*/)
+{
+    const Points* points = _positionDataset.get();
+
+    // The plugin outlives the extraction, the cache itself holds no state
+    const MappedFileCache* mappedFileCache = isPersistentCacheAllowed && isPersistentCacheEnabled(*points) ? &_mappedFileCache : nullptr;
+
+    // The data version token is part of the key, so positions of other data are never loaded
+    const auto fileKey      = mappedFileCache != nullptr ? QString("positions/%1/%2/%3/%4").arg(positionsKey.datasetId, getDataVersionToken()).arg(positionsKey.dimensionX).arg(positionsKey.dimensionY) : QString();
+    const auto isPersisted  = mappedFileCache != nullptr && mappedFileCache->contains(fileKey);
+
+    // Positions which are paged in from disk do not need to be gathered
+    if (isPersisted) {
+        startPositionsWorker(positionsKey, {}, mappedFileCache, fileKey, true);
+        return;
+    }
+
+    _positionsGather                    = PositionsGather();
+    _positionsGather.key                = positionsKey;
+    _positionsGather.mappedFileCache    = mappedFileCache;
+    _positionsGather.fileKey            = fileKey;
+
+    // Producers may modify the dataset at any time on the GUI thread, so the worker never reads its storage: the two columns are gathered here
+    if (getFloatData(*points) != nullptr) {
+        _positionsGather.numberOfPoints = points->getNumPoints();
+        _positionsGather.positions.reserve(_positionsGather.numberOfPoints);
+    }
+    else {
+
+        // Subsets and other element types go through the generic extraction at once
+        points->extractDataForDimensions(_positionsGather.positions, positionsKey.dimensionX, positionsKey.dimensionY);
+
+        _positionsGather.numberOfPoints = static_cast<std::uint32_t>(_positionsGather.positions.size());
+    }
+
+    gatherPositions();
+}
+
+void ScatterplotPlugin::gatherPositions()
+{
+    auto& positionsGather = _positionsGather;
+
+    const auto isRequested  = positionsGather.key == _requestedPositionsKey && positionsGather.key.version == _positionsVersion && _positionDataset.isValid() && positionsGather.key.datasetId == _positionDataset->getId();
+    const auto isGathered   = positionsGather.positions.size() == positionsGather.numberOfPoints;
+    const auto data         = isRequested && !isGathered && _positionDataset->getNumPoints() == positionsGather.numberOfPoints ? getFloatData(*_positionDataset) : nullptr;
+
+    // Stop gathering when other positions were requested or the data changed in the meantime
+    if (!isRequested || (!isGathered && data == nullptr)) {
+        _positionsGather = PositionsGather();
+
+        updateRequestedPositions();
+        return;
+    }
+
+    if (!isGathered) {
+        const auto numberOfDimensions   = _positionDataset->getNumDimensions();
+        const auto sliceBegin           = static_cast<std::uint32_t>(positionsGather.positions.size());
+        const auto sliceSize            = std::min(positionsGather.numberOfPoints - sliceBegin, POSITIONS_GATHER_SLICE);
+
+        positionsGather.positions.resize(sliceBegin + sliceSize);
+
+        PositionView(data + static_cast<std::size_t>(sliceBegin) * numberOfDimensions, sliceSize, numberOfDimensions, positionsGather.key.dimensionX, positionsGather.key.dimensionY).copyTo(positionsGather.positions.data() + sliceBegin);
+
+        // Continue in the next event loop turn
+        if (positionsGather.positions.size() < positionsGather.numberOfPoints) {
+            _positionsGatherTimer.start();
+            return;
+        }
+    }
+
+    auto completedGather = std::move(positionsGather);
+
+    _positionsGather = PositionsGather();
+
+    startPositionsWorker(completedGather.key, std::move(completedGather.positions), completedGather.mappedFileCache, completedGather.fileKey, false);
+}
+
+void ScatterplotPlugin::startPositionsWorker(const PositionCache::Key& positionsKey, std::vector<Vector2f>&& positions, const MappedFileCache* mappedFileCache, const QString& fileKey, bool isPersisted)
+{
+    // The pyramid of very large datasets is built along with the grid index
+    const auto isPointGridPyramidRequired = isLevelOfDetailEnabled(_positionDataset->getNumPoints());
+
+    _positionsWatcher.setFuture(QtConcurrent::run([positions = std::move(positions), positionsKey, mappedFileCache, fileKey, isPersisted, isPointGridPyramidRequired]() mutable -> PositionFrame {
+        PositionFrame positionFrame;
+
+        positionFrame.key = positionsKey;
+
+        // Page the positions in from a previous session, or compute the bounds of the gathered positions
+        if (isPersisted) {
+            positionFrame.isComplete = mappedFileCache->loadPositions(fileKey, positions, positionFrame.bounds);
+        }
+        else {
+            positionFrame.bounds = bounds::getFiniteBounds(PositionView(positions));
+
+            if (mappedFileCache != nullptr)
+                mappedFileCache->storePositions(fileKey, positions, positionFrame.bounds);
+        }
+
+        positionFrame.positions = std::make_shared<const std::vector<Vector2f>>(std::move(positions));
+
+        if (positionFrame.isComplete)
+            preparePositionFrame(positionFrame, isPointGridPyramidRequired);
+
+        return positionFrame;
+    }));
+}
+
+void ScatterplotPlugin::startPositionsIndexing(PositionCache::Entry&& cacheEntry)
+{
+    const auto isPointGridPyramidRequired = isLevelOfDetailEnabled(cacheEntry.positions ? cacheEntry.positions->size() : cacheEntry.quantizedPositions.size());
+
+    _positionsWatcher.setFuture(QtConcurrent::run([cacheEntry = std::move(cacheEntry), isPointGridPyramidRequired]() mutable -> PositionFrame {
+        PositionFrame positionFrame;
+
+        positionFrame.key       = cacheEntry.key;
+        positionFrame.bounds    = cacheEntry.bounds;
+
+        // Restore quantized positions
+        if (cacheEntry.positions) {
+            positionFrame.positions = std::move(cacheEntry.positions);
+        }
+        else {
+            std::vector<Vector2f> positions;
+
+            cacheEntry.quantizedPositions.dequantize(positions);
+
+            positionFrame.positions = std::make_shared<const std::vector<Vector2f>>(std::move(positions));
+        }
+
+        preparePositionFrame(positionFrame, isPointGridPyramidRequired);
+
+        return positionFrame;
+    }));
+}
+
+void ScatterplotPlugin::preparePositionFrame(PositionFrame& positionFrame, bool isPointGridPyramidRequired)
+{
+    const PositionView positionView(*positionFrame.positions);
+
+    // Computed once per frame, whether they are drawn depends on a setting which may change later
+    positionFrame.robustBounds = bounds::getRobustBounds(positionView, ROBUST_BOUNDS_QUANTILE, 1.0f - ROBUST_BOUNDS_QUANTILE);
+
+    // Index the points for selection hit testing
+    auto gridIndex = std::make_shared<PointGridIndex>();
+
+    gridIndex->build(positionView, getGridBounds(positionFrame.bounds));
+
+    positionFrame.gridIndex = std::move(gridIndex);
+
+    if (isPointGridPyramidRequired)
+        positionFrame.pointGridPyramid = buildPointGridPyramid(positionView, positionFrame.bounds);
+}
+
+bool ScatterplotPlugin::isExtractingPositions() const
+{
+    return _positionsGatherTimer.isActive() || _positionsWatcher.isRunning();
+}
+
+void ScatterplotPlugin::updateRequestedPositions()
+{
+    // Extract the requested positions unless they were swapped in already
+    if (_requestedPositionsKey != _positionsKey)
+        updateData();
+
+    // Flush the updates which were held back for the extraction when no other extraction took its place
+    if (!isExtractingPositions() && _updateFlags.toInt() != 0)
+        _updateTimer.start();
+}
+
+void ScatterplotPlugin::positionsExtracted()
+{
+    auto positionFrame = _positionsWatcher.future().takeResult();
+
+    // Extract the positions from the dataset when their cache file did not load
+    if (!positionFrame.isComplete && positionFrame.key == _requestedPositionsKey && positionFrame.key.version == _positionsVersion) {
+        startPositionsExtraction(positionFrame.key, false);
+        return;
+    }
+
+    // Positions of a data version which is still current may be requested again later, the rest is of no use anymore (the data may have changed before the next update)
+    if (!positionFrame.isComplete || positionFrame.key != _requestedPositionsKey || positionFrame.key.version != _positionsVersion) {
+        if (positionFrame.isComplete && _positionDataset.isValid() && positionFrame.key.datasetId == _positionDataset->getId() && positionFrame.key.version == _positionsVersion)
+            _positionCache.insert(positionFrame.key, positionFrame.positions, positionFrame.bounds, positionFrame.robustBounds, positionFrame.gridIndex);
+
+        updateRequestedPositions();
+        return;
     }
+
+    applyPositionFrame(std::move(positionFrame));
 }
 
-void ScatterplotPlugin::calculatePositions(const Points& points)
+void ScatterplotPlugin::applyPositionFrame(PositionFrame&& positionFrame)
 {
-    points.extractDataForDimensions(_positions, _settingsAction.getPositionAction().getDimensionX(), _settingsAction.getPositionAction().getDimensionY());
+    const auto appendedFrom = positionFrame.appendedFrom;
+
+    // Ensure that if positionDataset has now more points, the additional points are plotted (only the scalars of appended points are computed below)
+    if (_numPoints != _positionDataset->getNumPoints() && appendedFrom == 0)
+        requestUpdate(PointSize | PointOpacity | Colors);
+
+    // Pending and in-flight selection updates refer to the previous positions
+    _selectionScheduler.cancel();
+    cancelSelectionComputation();
+
+    // Determine number of points depending on if its a full dataset or a subset
+    _numPoints = _positionDataset->getNumPoints();
+
+    // Park the previous positions in the cache and swap in the new ones
+    if (_positionsKey != positionFrame.key)
+        parkPositions();
+
+    _positions          = std::move(positionFrame.positions);
+    _positionsBounds        = positionFrame.bounds;
+    _positionsRobustBounds  = positionFrame.robustBounds;
+    _positionsKey       = positionFrame.key;
+    _pointGridIndex     = std::move(positionFrame.gridIndex);
+    _pointGridPyramid   = std::move(positionFrame.pointGridPyramid);
+
+    // Level of detail may have been turned off during the extraction
+    if (!isLevelOfDetailEnabled(_positions->size()))
+        _pointGridPyramid.reset();
+
+    // Pass the 2D points to the scatter plot widget
+    uploadPositions();
+
+    _selectionStroke.reset();
+
+    // The renderer received new points, so upload all highlights again
+    _highlights.reset();
+    _selectionEcho = SelectionEcho();
+
+    updateSelection();
+
+    if (appendedFrom > 0) {
+        _settingsAction.getPlotAction().getPointPlotAction().appendScatterPlotWidgetPointScalars(appendedFrom);
+
+        requestUpdate(Colors);
+    }
+
+    // The maximum density depends on the positions
+    requestUpdate(Density);
+
+    // Drop the pyramid when level of detail was turned off, or build it when it was turned on during the extraction
+    updatePointGridPyramid();
+}
+
+bool ScatterplotPlugin::updateAppendedPositions(const PositionCache::Key& positionsKey)
+{
+    const auto previousNumberOfPoints   = static_cast<std::uint32_t>(_positions->size());
+    const auto isSameDimensions         = positionsKey.datasetId == _positionsKey.datasetId && positionsKey.dimensionX == _positionsKey.dimensionX && positionsKey.dimensionY == _positionsKey.dimensionY;
+
+    // Only newer data of the drawn positions can be an append
+    if (!isSameDimensions || positionsKey.version == _positionsKey.version || previousNumberOfPoints == 0 || _positionDataset->getNumPoints() <= previousNumberOfPoints || isExtractingPositions())
+        return false;
+
+    // Only the appended points are gathered on the GUI thread
+    std::vector<Vector2f> appendedPositions;
+
+    if (!appendPositions(*_positionDataset, positionsKey.dimensionX, positionsKey.dimensionY, *_positions, appendedPositions))
+        return false;
+
+    const auto isPointGridPyramidRequired = isLevelOfDetailEnabled(_positionDataset->getNumPoints());
+
+    // Concatenate the positions, grow the bounds and index the points on the thread pool, the frame is swapped in like extracted positions
+    _positionsWatcher.setFuture(QtConcurrent::run([positionsKey, previousPositions = _positions, previousBounds = _positionsBounds, appendedPositions = std::move(appendedPositions), isPointGridPyramidRequired]() -> PositionFrame {
+        PositionFrame positionFrame;
+
+        positionFrame.key           = positionsKey;
+        positionFrame.appendedFrom  = static_cast<std::uint32_t>(previousPositions->size());
+        positionFrame.bounds        = previousBounds;
+
+        auto positions = std::make_shared<std::vector<Vector2f>>();
+
+        positions->reserve(previousPositions->size() + appendedPositions.size());
+        positions->insert(positions->end(), previousPositions->begin(), previousPositions->end());
+        positions->insert(positions->end(), appendedPositions.begin(), appendedPositions.end());
+
+        bounds::growFiniteBounds(PositionView(appendedPositions), positionFrame.bounds);
+
+        positionFrame.positions = std::move(positions);
+
+        // The cells of the grid index depend on the bounds
+        preparePositionFrame(positionFrame, isPointGridPyramidRequired);
+
+        return positionFrame;
+    }));
+
+    return true;
+}
+
+bool ScatterplotPlugin::appendPositions(const Points& points, std::int32_t dimensionX, std::int32_t dimensionY, const std::vector<Vector2f>& positions, std::vector<Vector2f>& appendedPositions)
+{
+    const auto previousNumberOfPoints   = static_cast<std::uint32_t>(positions.size());
+    const auto numberOfPoints           = points.getNumPoints();
+    const auto numberOfDimensions       = points.getNumDimensions();
+
+    // The indices of subsets may have changed arbitrarily, only full datasets are checked for appended points
+    if (numberOfPoints <= previousNumberOfPoints)
+        return false;
+
+    const auto data = getFloatData(points);
+
+    if (data == nullptr)
+        return false;
+
+    const PositionView positionView(data, numberOfPoints, numberOfDimensions, dimensionX, dimensionY);
+
+    // Cheap check of the unchanged prefix: compare evenly spaced previous points (the last one included) bitwise, so that NaN matches NaN
+    const auto numberOfSamples = std::min(previousNumberOfPoints, APPEND_CHECK_SAMPLES);
+
+    for (std::uint32_t sampleIndex = 1; sampleIndex <= numberOfSamples; sampleIndex++) {
+        const auto localIndex   = static_cast<std::uint32_t>(static_cast<std::uint64_t>(previousNumberOfPoints) * sampleIndex / numberOfSamples) - 1;
+        const auto x            = positionView.getX(localIndex);
+        const auto y            = positionView.getY(localIndex);
+
+        if (std::memcmp(&x, &positions[localIndex].x, sizeof(float)) != 0 || std::memcmp(&y, &positions[localIndex].y, sizeof(float)) != 0)
+            return false;
+    }
+
+    appendedPositions.resize(numberOfPoints - previousNumberOfPoints);
+
+    PositionView(data + static_cast<std::size_t>(previousNumberOfPoints) * numberOfDimensions, numberOfPoints - previousNumberOfPoints, numberOfDimensions, dimensionX, dimensionY).copyTo(appendedPositions.data());
+
+    return true;
+}
+
+void ScatterplotPlugin::parkPositions()
+{
+    // The cache only holds all positions of the current data of the position dataset, other datasets may change unnoticed
+    if (!_positionDataset.isValid() || _positionsKey.datasetId != _positionDataset->getId() || _positionsKey.version != _positionsVersion)
+        return;
+
+    _positionCache.insert(_positionsKey, _positions, _positionsBounds, _positionsRobustBounds, _pointGridIndex);
+
+    if (_positionCache.isCompact())
+        qCDebug(performanceLog) << "Position cache maximum quantization error:" << _positionCache.getMaximumQuantizationError();
+}
+
+bool ScatterplotPlugin::isPersistentCacheEnabled(const Points& points)
+{
+    return _settingsAction.getMiscellaneousAction().getPersistentCacheAction().isChecked() && points.getNumPoints() >= PERSISTENT_CACHE_THRESHOLD;
+}
+
+QString ScatterplotPlugin::getDataVersionToken()
+{
+    auto& dataVersionTokenAction            = _settingsAction.getMiscellaneousAction().getDataVersionTokenAction();
+    auto& dataVersionTokenDatasetIdAction   = _settingsAction.getMiscellaneousAction().getDataVersionTokenDatasetIdAction();
+
+    // The data of another dataset might have changed while it was not watched
+    if (dataVersionTokenAction.getString().isEmpty() || dataVersionTokenDatasetIdAction.getString() != _positionDataset->getId()) {
+        dataVersionTokenAction.setString(QUuid::createUuid().toString(QUuid::WithoutBraces));
+        dataVersionTokenDatasetIdAction.setString(_positionDataset->getId());
+    }
+
+    return dataVersionTokenAction.getString();
+}
+
+void ScatterplotPlugin::uploadPositions()
+{
+    // Robust bounds leave the outliers out of view, the grid index, pyramid and caches keep using the bounds of all finite positions
+    if (_settingsAction.getMiscellaneousAction().getRobustBoundsAction().isChecked())
+        _scatterPlotWidget->setData(_positions, _positionsRobustBounds, _pointGridPyramid);
+    else
+        _scatterPlotWidget->setData(_positions, _positionsBounds, _pointGridPyramid);
+}
+
+void ScatterplotPlugin::reuploadPositions()
+{
+    if (!_positionDataset.isValid())
+        return;
+
+    uploadPositions();
+
+    _highlights.reset();
+
+    updateHighlights();
+}
+
+bool ScatterplotPlugin::isLevelOfDetailEnabled(std::size_t numberOfPoints)
+{
+    return _settingsAction.getMiscellaneousAction().getLevelOfDetailAction().isChecked() && numberOfPoints >= LEVEL_OF_DETAIL_THRESHOLD;
+}
+
+std::shared_ptr<const PointGridPyramid> ScatterplotPlugin::buildPointGridPyramid(const PositionView& positionView, const Bounds& positionsBounds)
+{
+    auto pointGridPyramid = std::make_shared<PointGridPyramid>();
+
+    pointGridPyramid->build(positionView, getGridBounds(positionsBounds));
+
+    return pointGridPyramid;
+}
+
+void ScatterplotPlugin::updatePointGridPyramid()
+{
+    if (!_positionDataset.isValid())
+        return;
+
+    if (!isLevelOfDetailEnabled(_positions->size())) {
+        if (_pointGridPyramid) {
+            _pointGridPyramid.reset();
+
+            reuploadPositions();
+        }
+
+        return;
+    }
+
+    if (_pointGridPyramid || _pointGridPyramidWatcher.isRunning())
+        return;
+
+    // The worker builds from a snapshot of the current positions, which may be swapped in the meantime
+    _pointGridPyramidWatcher.setFuture(QtConcurrent::run([positionsKey = _positionsKey, positions = _positions, positionsBounds = _positionsBounds]() -> PointGridPyramidFrame {
+        return { positionsKey, buildPointGridPyramid(PositionView(*positions), positionsBounds) };
+    }));
+}
+
+void ScatterplotPlugin::pointGridPyramidBuilt()
+{
+    auto pointGridPyramidFrame = _pointGridPyramidWatcher.future().takeResult();
+
+    // The positions may have changed (or level of detail was turned off) while the pyramid was built
+    if (pointGridPyramidFrame.key != _positionsKey || _pointGridPyramid || !isLevelOfDetailEnabled(_positions->size())) {
+        updatePointGridPyramid();
+        return;
+    }
+
+    _pointGridPyramid = std::move(pointGridPyramidFrame.pointGridPyramid);
+
+    reuploadPositions();
+}
+
+bool ScatterplotPlugin::hasCurrentPositions() const
+{
+    return _positionsKey.datasetId == _requestedPositionsKey.datasetId && _positionsKey.version == _requestedPositionsKey.version;
+}
+
+Bounds ScatterplotPlugin::getGridBounds(const Bounds& positionsBounds)
+{
+    auto gridBounds = positionsBounds;
+
+    // Degenerate bounds (e.g. all points on a line) cannot be divided into cells
+    gridBounds.ensureMinimumSize(1e-07f, 1e-07f);
+
+    return gridBounds;
+}
+
+const float* ScatterplotPlugin::getFloatData(const Points& points)
+{
+    const auto numberOfPoints       = points.getNumPoints();
+    const auto numberOfDimensions   = points.getNumDimensions();
+
+    if (!points.isFull() || numberOfPoints == 0)
+        return nullptr;
+
+    const float* data = nullptr;
+
+    points.constVisitFromBeginToEnd([&data, numberOfPoints, numberOfDimensions](auto begin, auto end) -> void {
+        using ValueType = std::decay_t<decltype(*begin)>;
+
+        if constexpr (std::is_same_v<ValueType, float>) {
+            if (begin == end || static_cast<std::size_t>(end - begin) < static_cast<std::size_t>(numberOfPoints) * numberOfDimensions)
+                return;
+
+            data = &*begin;
+        }
+    });
+
+    return data;
 }
 
 void ScatterplotPlugin::updateSelection()
@@ -726,21 +1762,102 @@ void ScatterplotPlugin::updateSelection()
     if (!_positionDataset.isValid())
         return;
 
+    // The number of drawn points may not match the dataset, the selection is synchronized again when the current positions are swapped in
+    if (!hasCurrentPositions()) {
+        requestUpdate(Highlights);
+        return;
+    }
+
     //Timer timer(__FUNCTION__);
 
-    auto selection = _positionDataset->getSelection<Points>();
+    const auto numberOfPoints   = _positionDataset->getNumPoints();
+    const auto selection        = _positionDataset->getSelection<Points>();
+
+    // Skip the echo of a selection this view made itself, its local selection and highlights are up to date already
+    if (_selectionEcho.pending) {
+        const auto isEcho = selection->indices == _selectionEcho.indices && _localSelection.getNumberOfPoints() == numberOfPoints;
+
+        _selectionEcho = SelectionEcho();
+
+        if (isEcho)
+            return;
+    }
+
+    const auto& globalIndexTable = getGlobalIndexTable();
+
+    std::vector<std::uint32_t> localSelectionIndices;
+
+    localSelectionIndices.reserve(selection->indices.size());
+
+    // Resolve the local selection once, all consumers read the cached bitset
+    for (const auto& globalIndex : selection->indices) {
+        const auto localIndex = globalIndexTable.getLocalIndex(globalIndex);
+
+        if (localIndex != GlobalIndexTable::INVALID_INDEX)
+            localSelectionIndices.push_back(localIndex);
+    }
+
+    _localSelection.assign(numberOfPoints, localSelectionIndices);
+
+    updateHighlights();
+
+    emit localSelectionChanged();
+}
+
+void ScatterplotPlugin::updateHighlights()
+{
+    // Highlights of positions of other data would not line up with the drawn points
+    if (!hasCurrentPositions()) {
+        requestUpdate(Highlights);
+        return;
+    }
+
+    const auto numberOfPoints = _localSelection.getNumberOfPoints();
+
+    // Patch the highlights which changed since the previous upload when the highlights are in sync with the points
+    if (_highlights && _highlights->size() == numberOfPoints && _highlightedSelection.getNumberOfPoints() == numberOfPoints) {
+        const auto numberOfDifferences = _localSelection.getNumberOfDifferences(_highlightedSelection);
+
+        // Nothing to upload when the selection of the displayed points did not change
+        if (numberOfDifferences == 0)
+            return;
+
+        // The point renderer only takes complete highlight buffers, so patching saves rebuilding them but not uploading them
+        const auto highlightsPatchRatio = _settingsAction.getMiscellaneousAction().getHighlightsPatchRatioAction().getValue();
+
+        if (numberOfDifferences <= highlightsPatchRatio * numberOfPoints) {
+            // The widget may still aggregate the uploaded highlights on the thread pool, so these are copied instead of patched in place
+            if (_highlights.use_count() > 1)
+                _highlights = std::make_shared<std::vector<char>>(*_highlights);
 
-    std::vector<bool> selected;
-    std::vector<char> highlights;
+            auto& highlights = *_highlights;
 
-    _positionDataset->selectedLocalIndices(selection->indices, selected);
+            _localSelection.forEachDifference(_highlightedSelection, [&highlights](std::uint32_t localIndex, bool selected) -> void {
+                highlights[localIndex] = selected ? 1 : 0;
+            });
+        }
+        else {
+            rebuildHighlights();
+        }
+    }
+    else {
+        rebuildHighlights();
+    }
+
+    _highlightedSelection = _localSelection;
+
+    _scatterPlotWidget->setHighlights(_highlights, static_cast<std::int32_t>(_localSelection.getNumberOfSelectedPoints()));
+}
 
-    highlights.resize(_positionDataset->getNumPoints(), 0);
+void ScatterplotPlugin::rebuildHighlights()
+{
+    _highlights = std::make_shared<std::vector<char>>(_localSelection.getNumberOfPoints(), 0);
 
-    for (int i = 0; i < selected.size(); i++)
-        highlights[i] = selected[i] ? 1 : 0;
+    auto& highlights = *_highlights;
 
-    _scatterPlotWidget->setHighlights(highlights, static_cast<std::int32_t>(selection->indices.size()));
+    _localSelection.forEachSelected([&highlights](std::uint32_t localIndex) -> void {
+        highlights[localIndex] = 1;
+    });
 }
 
 void ScatterplotPlugin::fromVariantMap(const QVariantMap& variantMap)
@@ -765,6 +1882,7 @@ QVariantMap ScatterplotPlugin::toVariantMap() const
     _settingsAction.insertIntoVariantMap(variantMap);
     _scatterplotColorControlAction.insertIntoVariantMap(variantMap);
     _selectedCrossSpeciesCluster.insertIntoVariantMap(variantMap);
+
     return variantMap;
 }
 
@@ -778,12 +1896,64 @@ std::uint32_t ScatterplotPlugin::getNumberOfPoints() const
 
 void ScatterplotPlugin::setXDimension(const std::int32_t& dimensionIndex)
 {
-    updateData();
+    requestUpdate(Positions);
 }
 
 void ScatterplotPlugin::setYDimension(const std::int32_t& dimensionIndex)
 {
-    updateData();
+    requestUpdate(Positions);
+}
+
+void ScatterplotPlugin::requestUpdate(UpdateFlags updateFlags)
+{
+    _updateFlags |= updateFlags;
+
+    if (!_updateTimer.isActive())
+        _updateTimer.start();
+}
+
+void ScatterplotPlugin::flushUpdates()
+{
+    auto updateFlags = _updateFlags;
+
+    _updateFlags = UpdateFlags();
+
+    if (updateFlags.testFlag(Positions)) {
+        updateData();
+
+        // Updating the positions may raise other flags, handle those in this flush as well
+        updateFlags |= _updateFlags;
+
+        _updateFlags = UpdateFlags();
+        _updateTimer.stop();
+
+        // Hold back the other updates until the extracted positions are swapped in, so that they match the drawn points
+        if (isExtractingPositions()) {
+            _updateFlags = updateFlags & ~UpdateFlags(Positions);
+            return;
+        }
+    }
+
+    auto& pointPlotAction = _settingsAction.getPlotAction().getPointPlotAction();
+
+    if (updateFlags.testFlag(PointSize))
+        pointPlotAction.updateScatterPlotWidgetPointSizeScalars();
+
+    if (updateFlags.testFlag(PointOpacity))
+        pointPlotAction.updateScatterPlotWidgetPointOpacityScalars();
+
+    if (updateFlags.testFlag(Colors))
+        _settingsAction.getColoringAction().updateScatterPlotWidgetColors();
+
+    if (updateFlags.testFlag(Density))
+        _settingsAction.getPlotAction().getDensityPlotAction().updateDensity();
+
+    // Otherwise swapping in the current positions synchronizes the selection and uploads all highlights
+    if (updateFlags.testFlag(Highlights) && hasCurrentPositions()) {
+        _highlights.reset();
+
+        updateHighlights();
+    }
 }
 
 QIcon ScatterplotPluginFactory::getIcon(const QColor& color /*= Qt::black*/) const
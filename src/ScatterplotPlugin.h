@@ -14,8 +14,22 @@
 #include <QGraphicsItemGroup>	
 #include <QGraphicsItem>
 #include "SettingsAction.h"
+#include "GlobalIndexTable.h"
+#include "MappedFileCache.h"
+#include "PointGridIndex.h"
+#include "PointGridPyramid.h"
+#include "PositionCache.h"
+#include "PositionView.h"
+#include "SelectionBitset.h"
+#include "SelectionMask.h"
+#include "SelectionScheduler.h"
 
 #include <QTimer>
+#include <QImage>
+#include <QFutureWatcher>
+
+#include <atomic>
+#include <memory>
 
 using namespace mv::plugin;
 using namespace mv::util;
@@ -39,6 +53,20 @@ class ScatterplotPlugin : public ViewPlugin
 {
     Q_OBJECT
 
+public:
+
+    /** Parts of the scatter plot widget which can be updated (in a deferred manner) */
+    enum UpdateFlag {
+        Positions       = 0x01,     /** Point positions (and everything that depends on them) */
+        Colors          = 0x02,     /** Point colors */
+        PointSize       = 0x04,     /** Point size scalars */
+        PointOpacity    = 0x08,     /** Point opacity scalars */
+        Density         = 0x10,     /** Density sigma and color map range */
+        Highlights      = 0x20      /** All highlights */
+    };
+
+    Q_DECLARE_FLAGS(UpdateFlags, UpdateFlag)
+
 public:
     ScatterplotPlugin(const PluginFactory* factory);
     ~ScatterplotPlugin() override;
@@ -54,6 +82,15 @@ public:
     /** Get number of points in the position dataset */
     std::uint32_t getNumberOfPoints() const;
 
+    /**
+     * Mark \p updateFlags dirty, dirty parts are updated once in the next event loop turn
+     * @param updateFlags Parts of the scatter plot widget to update
+     */
+    void requestUpdate(UpdateFlags updateFlags);
+
+    /** Returns true when the drawn positions belong to the current data of the position dataset (they lag behind while extracting positions of other data) */
+    bool hasCurrentPositions() const;
+
 public:
     void createSubset(const bool& fromSourceData = false, const QString& name = "");
 
@@ -92,10 +129,22 @@ public: // Miscellaneous
     /** Use the pixel selection tool to select data points */
     void selectPoints();
 
+    /** Get the cached mapping between local and global point indices of the position dataset (built on first use) */
+    const GlobalIndexTable& getGlobalIndexTable();
+
+    /** Get the cached selection state of the points in the position dataset (by local index) */
+    const SelectionBitset& getLocalSelection() const { return _localSelection; }
+
 protected:
     /** Updates the window title (displays the name of the view and the GUI name of the loaded points dataset) */
     void updateWindowTitle();
 
+    /**
+     * Show a tooltip with information about the point nearest to \p widgetPosition (hides the tooltip when there is none)
+     * @param widgetPosition Mouse position in widget coordinates
+     */
+    void showHoverTooltip(const QPointF& widgetPosition);
+
 public:
 
     /** Get reference to the scatter plot widget */
@@ -105,9 +154,165 @@ public:
     StringAction& getSelectedCrossSpeciesClusterAction() { return _selectedCrossSpeciesCluster; }
     OptionAction& getScatterplotColorControlAction() { return _scatterplotColorControlAction; }
 private:
+
+    /** Complete set of positions which is swapped in at once */
+    struct PositionFrame {
+        PositionCache::Key                              key;                /** Identifies the positions */
+        std::shared_ptr<const std::vector<Vector2f>>    positions;          /** Point positions */
+        Bounds                                          bounds;             /** Bounds of the finite positions */
+        Bounds                                          robustBounds;       /** Bounds of the positions without the outliers */
+        std::shared_ptr<const PointGridIndex>           gridIndex;          /** Spatial index of the positions */
+        std::shared_ptr<const PointGridPyramid>         pointGridPyramid;   /** Pyramid of the positions (only when level of detail is enabled for them) */
+        bool                                            isComplete = true;  /** Whether the positions were produced (false when their cache file did not load) */
+        std::uint32_t                                   appendedFrom = 0;   /** Number of drawn points which the positions were appended to (zero when the positions were extracted in full) */
+    };
+
+    /** Positions which are gathered from the position dataset in slices, in between event loop turns */
+    struct PositionsGather {
+        PositionCache::Key          key;                            /** Identifies the positions */
+        std::vector<Vector2f>       positions;                      /** Positions which were gathered so far */
+        std::uint32_t               numberOfPoints = 0;             /** Number of points to gather */
+        const MappedFileCache*      mappedFileCache = nullptr;      /** Persistent cache to store the positions in (if any) */
+        QString                     fileKey;                        /** Key of the positions in the persistent cache */
+    };
+
+    /** Point grid pyramid of the positions which are identified by the key */
+    struct PointGridPyramidFrame {
+        PositionCache::Key                          key;                /** Identifies the positions */
+        std::shared_ptr<const PointGridPyramid>     pointGridPyramid;   /** Pyramid of the positions */
+    };
+
+    /** Update the parts of the scatter plot widget which were marked dirty */
+    void flushUpdates();
+
     void updateData();
-    void calculatePositions(const Points& points);
+
+    /**
+     * Gather the positions identified by \p positionsKey from the position dataset and compute their bounds and grid index on the thread pool
+     * @param positionsKey Key of the positions to extract
+     * @param isPersistentCacheAllowed Whether the positions may be loaded from (and stored in) the persistent cache
+     */
+    void startPositionsExtraction(const PositionCache::Key& positionsKey, bool isPersistentCacheAllowed = true);
+
+    /** Gather the next slice of the positions on the GUI thread, the bounds and grid index are computed on the thread pool once all positions are gathered */
+    void gatherPositions();
+
+    /**
+     * Compute the bounds and grid index of \p positions on the thread pool
+     * @param positionsKey Key of the positions
+     * @param positions Gathered positions (empty when they are paged in from the persistent cache)
+     * @param mappedFileCache Persistent cache to load the positions from or store them in (if any)
+     * @param fileKey Key of the positions in the persistent cache
+     * @param isPersisted Whether the positions are paged in from the persistent cache
+     */
+    void startPositionsWorker(const PositionCache::Key& positionsKey, std::vector<Vector2f>&& positions, const MappedFileCache* mappedFileCache, const QString& fileKey, bool isPersisted);
+
+    /**
+     * Restore the positions of \p cacheEntry when they are quantized and build their grid index on the thread pool
+     * @param cacheEntry Entry which was taken out of the position cache (moved into the computation)
+     */
+    void startPositionsIndexing(PositionCache::Entry&& cacheEntry);
+
+    /**
+     * Compute the robust bounds and build the grid index of the positions in \p positionFrame, along with their pyramid when \p isPointGridPyramidRequired (invoked on a worker thread)
+     * @param positionFrame Position frame with positions and bounds
+     * @param isPointGridPyramidRequired Whether to build the pyramid of the positions
+     */
+    static void preparePositionFrame(PositionFrame& positionFrame, bool isPointGridPyramidRequired);
+
+    /** Returns true while positions are gathered or computed, the drawn positions are swapped once that is done */
+    bool isExtractingPositions() const;
+
+    /** Extract the requested positions unless they were swapped in already, and flush the updates which were held back for the extraction when no other extraction took its place */
+    void updateRequestedPositions();
+
+    /** Swap in the extracted positions when they are still requested (on the GUI thread) */
+    void positionsExtracted();
+
+    /**
+     * Park the current positions in the cache and pass the positions of \p positionFrame to the scatter plot widget
+     * @param positionFrame Position frame (moved into the plugin)
+     */
+    void applyPositionFrame(PositionFrame&& positionFrame);
+
+    /**
+     * Extract only the appended points when the position dataset grew since the positions with the dimensions of \p positionsKey were extracted
+     * @param positionsKey Key of the requested positions
+     * @return Whether the update was handled as an append
+     */
+    bool updateAppendedPositions(const PositionCache::Key& positionsKey);
+
+    /**
+     * Gather the points of \p points beyond the size of \p positions, when its prefix appears unchanged
+     * @param points Points dataset
+     * @param dimensionX Index of the dimension to use as x-coordinate
+     * @param dimensionY Index of the dimension to use as y-coordinate
+     * @param positions Previously extracted point positions
+     * @param appendedPositions Positions of the appended points (output)
+     * @return Whether the points were appended
+     */
+    static bool appendPositions(const Points& points, std::int32_t dimensionX, std::int32_t dimensionY, const std::vector<Vector2f>& positions, std::vector<Vector2f>& appendedPositions);
+
+    /** Move the current positions into the cache when they can be requested again */
+    void parkPositions();
+
+    /** Returns true when the extracted positions of \p points are cached on disk */
+    bool isPersistentCacheEnabled(const Points& points);
+
+    /**
+     * Get the version token of the data of the position dataset, a new one is created when the data might have changed since the last one
+     * @return Version token which identifies the data in the persistent cache (persists with the project)
+     */
+    QString getDataVersionToken();
+
+    /** Pass the current positions (with their robust bounds when enabled) and their pyramid to the scatter plot widget */
+    void uploadPositions();
+
+    /** Pass the current positions to the scatter plot widget again, along with all highlights */
+    void reuploadPositions();
+
+    /**
+     * Get whether \p numberOfPoints positions are drawn as aggregated grid cells (when they are dense enough)
+     * @param numberOfPoints Number of point positions
+     * @return Whether level of detail is enabled for the positions
+     */
+    bool isLevelOfDetailEnabled(std::size_t numberOfPoints);
+
+    /**
+     * Build the point grid pyramid of \p positionView (on the thread pool)
+     * @param positionView View of the positions
+     * @param positionsBounds Bounds of the finite positions (the grid covers them all, so no outlier is drawn in a border cell)
+     * @return Point grid pyramid
+     */
+    static std::shared_ptr<const PointGridPyramid> buildPointGridPyramid(const PositionView& positionView, const Bounds& positionsBounds);
+
+    /** Drop the pyramid of the current positions when level of detail is not enabled for them, or build it on the thread pool when it is missing */
+    void updatePointGridPyramid();
+
+    /** Swap in the built pyramid when it belongs to the current positions (on the GUI thread) */
+    void pointGridPyramidBuilt();
+
+    /**
+     * Get the bounds of the grid index for positions with \p positionsBounds
+     * @param positionsBounds Bounds of the finite positions
+     * @return Grid index bounds
+     */
+    static Bounds getGridBounds(const Bounds& positionsBounds);
+
+    /**
+     * Get the float storage of \p points, from which positions can be gathered without extracting them
+     * @param points Points dataset
+     * @return Pointer to the first element (nullptr for subsets, other element types and empty datasets)
+     */
+    static const float* getFloatData(const Points& points);
+
     void updateSelection();
+
+    /** Update the highlights of the scatter plot widget from the cached local selection, only changed highlights are patched (the widget still receives all of them) */
+    void updateHighlights();
+
+    /** Rebuild all highlights from the cached local selection */
+    void rebuildHighlights();
     void handleSelection(QGraphicsItem* item);
     void mousePressEvent(QGraphicsSceneMouseEvent* event);
     void selectTextEllipse();
@@ -116,6 +321,92 @@ private:
     void scrollToHighlight();
     //void addHighlight();	
     void updateLegend(const Dataset<Clusters>& clusters);
+
+signals:
+
+    /** Signals that the cached local selection changed (emitted once per selection change of the position dataset) */
+    void localSelectionChanged();
+
+private:
+
+    /**
+     * State of a selection stroke, used to only hit test what changed between selection area updates
+     *
+     * The GUI thread only sets the identifier and the selection before the stroke, while no computation is in flight.
+     * The hit test state is only accessed by the computations of the stroke, which run one at a time.
+     */
+    struct SelectionStroke {
+        std::uint32_t                                       id = 0;             /** Identifier of the stroke */
+        std::shared_ptr<const std::vector<std::uint32_t>>   selectionIndices;   /** Selection before the stroke (sorted global indices, only for the add and subtract modifiers) */
+        std::shared_ptr<const SelectionMask>                selectionMask;      /** Selection mask of the previous update */
+        std::vector<std::uint8_t>                           hits;               /** Hit flag per local point index */
+        std::vector<std::uint32_t>                          hitIndices;         /** Sorted local indices of the hits */
+    };
+
+    /** Immutable snapshot of the selection state of the GUI and the data it applies to, the input of a selection computation */
+    struct SelectionRequest {
+        std::uint32_t                                   strokeId = 0;                                       /** Identifier of the selection stroke */
+        bool                                            isExact = false;                                    /** Whether to test against the selection shape instead of the area image */
+        bool                                            isRectangle = false;                                /** Whether the selection shape is a rectangle */
+        bool                                            isClick = false;                                    /** Whether to select around a click instead of in the selection area */
+        Vector2f                                        clickPosition;                                      /** Click position in data space */
+        float                                           clickRadius = 0.0f;                                 /** Select all points within this data space radius of the click (nearest point only when zero) */
+        float                                           pickRadius = 0.0f;                                  /** Maximum distance of the nearest point to the click */
+        QImage                                          areaImage;                                          /** Selection area image of the pixel selection tool */
+        Bounds                                          bounds;                                             /** Data bounds as displayed in the scatter plot widget */
+        std::vector<Vector2f>                           selectionShape;                                     /** Selection shape in data space */
+        PixelSelectionModifierType                      modifier = PixelSelectionModifierType::Replace;     /** Selection modifier */
+        std::shared_ptr<const std::vector<Vector2f>>    positions;                                          /** Positions as drawn */
+        std::shared_ptr<const PointGridIndex>           gridIndex;                                          /** Spatial index of the positions */
+        std::shared_ptr<const GlobalIndexTable>         globalIndexTable;                                   /** Mapping between local and global point indices */
+        std::shared_ptr<SelectionStroke>                selectionStroke;                                    /** State of the selection stroke */
+    };
+
+    /** Output of a selection computation */
+    struct SelectionResult {
+        bool                            cancelled = false;      /** Whether the computation was cancelled */
+        std::uint32_t                   generation = 0;         /** Generation of the data the selection was computed for */
+        std::vector<std::uint32_t>      selectionIndices;       /** Global indices of the new selection */
+        SelectionBitset                 localSelection;         /** Local selection state of the new selection */
+    };
+
+    /** Identifies the selection this view made itself, so that its echo through the dataset can be skipped */
+    struct SelectionEcho {
+        bool                            pending = false;        /** Whether the echo is still expected */
+        std::vector<std::uint32_t>      indices;                /** Selected (global) indices */
+    };
+
+    /**
+     * Select the point nearest to \p widgetPosition, or all points within the click radius
+     * @param widgetPosition Click position in widget coordinates
+     */
+    void selectClickedPoints(const QPointF& widgetPosition);
+
+    /**
+     * Compute the selection for \p selectionRequest, or queue it when a computation is in flight
+     * @param selectionRequest Selection request (moved into the computation)
+     */
+    void submitSelectionRequest(SelectionRequest&& selectionRequest);
+
+    /**
+     * Compute the selection for \p selectionRequest on the thread pool, along with snapshots of the current positions, grid index and global index table
+     * @param selectionRequest Selection request (moved into the computation)
+     */
+    void startSelectionComputation(SelectionRequest&& selectionRequest);
+
+    /** Cancel the pending and in-flight selection computations, without waiting (the result of the latter is discarded when it arrives) */
+    void cancelSelectionComputation();
+
+    /** Apply the result of the finished selection computation (on the GUI thread) */
+    void selectionComputed();
+
+    /**
+     * Compute the selection for \p selectionRequest (invoked on a worker thread, only reads the snapshots in the request)
+     * @param selectionRequest Selection request
+     * @return Selection result
+     */
+    SelectionResult computeSelection(const SelectionRequest& selectionRequest);
+
 public: // Serialization
 
     /**
@@ -133,11 +424,44 @@ public: // Serialization
 private:
     Dataset<Points>                 _positionDataset;           /** Smart pointer to points dataset for point position */
     Dataset<Points>                 _positionSourceDataset;     /** Smart pointer to source of the points dataset for point position (if any) */
-    std::vector<mv::Vector2f>     _positions;                 /** Point positions */
+    std::shared_ptr<const std::vector<mv::Vector2f>>    _positions; /** Point positions, as uploaded to the scatter plot widget (shared with in-flight computations) */
+    PositionCache                   _positionCache;             /** Recently used positions of other pairs of dimensions of the position dataset */
+    PositionCache::Key              _positionsKey;              /** Identifies the current point positions */
+    Bounds                          _positionsBounds;           /** Bounds of the finite current point positions */
+    Bounds                          _positionsRobustBounds;     /** Bounds of the current point positions without the outliers (computed along with the positions) */
+    std::uint32_t                   _positionsVersion;          /** Incremented when the data of the position dataset changes */
+    MappedFileCache                 _mappedFileCache;           /** Persistent cache of extracted positions of large datasets */
+    PositionsGather                 _positionsGather;           /** Positions which are being gathered from the position dataset */
+    QTimer                          _positionsGatherTimer;      /** Gathers the next slice of the positions in the next event loop turn */
+    QFutureWatcher<PositionFrame>   _positionsWatcher;          /** Watches the in-flight extraction of positions */
+    PositionCache::Key              _requestedPositionsKey;     /** Identifies the most recently requested positions */
+    std::shared_ptr<const PointGridIndex>   _pointGridIndex;    /** Spatial index of the point positions for selection hit testing (shared with in-flight computations) */
+    std::shared_ptr<const PointGridPyramid> _pointGridPyramid;  /** Pyramid of the point positions for level of detail (shared with the scatter plot widget) */
+    QFutureWatcher<PointGridPyramidFrame>   _pointGridPyramidWatcher;   /** Watches the in-flight build of the pyramid of the current positions */
+    std::shared_ptr<SelectionStroke>    _selectionStroke;       /** State of the current selection stroke (replaced instead of reset, so that an in-flight computation keeps its own) */
+    std::uint32_t                   _selectionStrokeId;         /** Identifier of the current selection stroke */
+    QFutureWatcher<SelectionResult> _selectionWatcher;          /** Watches the in-flight selection computation */
+    std::atomic<bool>               _selectionCancelled;        /** Whether the in-flight selection computation should stop */
+    std::uint32_t                   _selectionGeneration;       /** Incremented when the data changes, results of older generations are discarded */
+    SelectionRequest                _pendingSelectionRequest;   /** Latest request which arrived while a computation was in flight */
+    bool                            _hasPendingSelectionRequest;/** Whether there is a pending selection request */
+    QPointF                         _clickPosition;             /** Position of the last click (widget coordinates) */
+    std::uint32_t                   _clickSelectionStrokeId;    /** Selection stroke in which the last click occurred */
+    std::shared_ptr<const GlobalIndexTable> _globalIndexTable;  /** Cached mapping between local and global point indices (replaced instead of invalidated, it is shared with in-flight computations) */
+    SelectionBitset                 _localSelection;            /** Cached selection state of the points in the position dataset */
+    SelectionBitset                 _highlightedSelection;      /** Selection state of the highlights which were uploaded last */
+    std::shared_ptr<std::vector<char>> _highlights;             /** Highlight per point, as uploaded to the scatter plot widget (shared with it while it aggregates them per cell) */
+    SelectionEcho                   _selectionEcho;             /** Selection which is expected to echo back from the position dataset */
+    std::vector<std::int32_t>       _hoverClusterIndices;       /** Cluster index per point for the hover tooltip (-1 when not in a cluster) */
+    QStringList                     _hoverClusterNames;         /** Cluster names for the hover tooltip */
+    Dataset<Points>                 _hoverScalarsDataset;       /** Dataset whose values color the points, read for the hover tooltip */
+    std::uint32_t                   _hoverScalarsDimension;     /** Dimension of the hover scalars dataset which colors the points */
+    QString                         _hoverScalarsDimensionName; /** Name of the dimension which colors the points (looked up once per coloring, not per mouse move) */
     unsigned int                    _numPoints;                 /** Number of point positions */
-    QTimer                          _selectPointsTimer;         /** Timer to limit the refresh rate of selection updates */
+    SelectionScheduler              _selectionScheduler;        /** Limits the rate of selection updates while selecting */
+    UpdateFlags                     _updateFlags;               /** Parts of the scatter plot widget which are dirty */
+    QTimer                          _updateTimer;               /** Flushes the dirty parts in the next event loop turn */
     StringAction        _selectedCrossSpeciesCluster;
-    static const std::int32_t LAZY_UPDATE_INTERVAL = 2;
     QGraphicsScene          _scene;
     OptionAction                 _scatterplotColorControlAction;
 protected:
@@ -146,8 +470,23 @@ protected:
     SettingsAction              _settingsAction;            /** Group action for all settings */
     HorizontalToolbarAction     _primaryToolbarAction;      /** Horizontal toolbar for primary content */
     HorizontalToolbarAction     _secondaryToolbarAction;    /** Secondary toolbar for secondary content */
+
+    static constexpr int    PICK_RADIUS             = 6;        /** Radius around the cursor in which points are picked for the hover tooltip and click selection (in pixels) */
+
+    static constexpr std::uint32_t  APPEND_CHECK_SAMPLES    = 64;                   /** Number of previous points which are compared to detect an append */
+    static constexpr std::size_t    POSITION_CACHE_CAPACITY = 256 * 1024 * 1024;    /** Maximum total size of the cached positions (in bytes) */
+    static constexpr std::uint32_t  POSITIONS_GATHER_SLICE  = 1000000;              /** Number of points which are gathered from the position dataset per event loop turn */
+
+    static constexpr std::uint32_t  PERSISTENT_CACHE_THRESHOLD  = 1000000;                      /** Number of points from which extracted positions are cached on disk */
+    static constexpr std::uint64_t  PERSISTENT_CACHE_CAPACITY   = 8ull * 1024 * 1024 * 1024;    /** Maximum total size of the cache files (in bytes) */
+
+    static constexpr float          ROBUST_BOUNDS_QUANTILE      = 0.001f;   /** Fraction of the points on each side of each axis which robust bounds leave out */
+
+    static constexpr std::uint32_t  LEVEL_OF_DETAIL_THRESHOLD   = 10000000; /** Number of points from which the points may be drawn as aggregated grid cells */
 };
 
+Q_DECLARE_OPERATORS_FOR_FLAGS(ScatterplotPlugin::UpdateFlags)
+
 // =============================================================================
 // Factory
 // =============================================================================
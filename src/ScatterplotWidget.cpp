@@ -1,44 +1,46 @@
 #include "ScatterplotWidget.h"
+#include "PositionBounds.h"
 #include "Application.h"
 
 #include "util/PixelSelectionTool.h"
 #include "util/Math.h"
 #include "util/Exception.h"
 
+#include <cmath>
 #include <vector>
 
+#include <QApplication>
 #include <QSize>
 #include <QPainter>
 #include <QDebug>
 #include <QOpenGLFramebufferObject>
 #include <QWindow>
+#include <QtConcurrent>
 
 #include <math.h>
 
-namespace
-{
-    Bounds getDataBounds(const std::vector<Vector2f>& points)
-    {
-        Bounds bounds = Bounds::Max;
-
-        for (const Vector2f& point : points)
-        {
-            bounds.setLeft(std::min(point.x, bounds.getLeft()));
-            bounds.setRight(std::max(point.x, bounds.getRight()));
-            bounds.setBottom(std::min(point.y, bounds.getBottom()));
-            bounds.setTop(std::max(point.y, bounds.getTop()));
-        }
-
-        return bounds;
-    }
-}
-
 ScatterplotWidget::ScatterplotWidget() :
     _densityRenderer(DensityRenderer::RenderMode::DENSITY),
     _backgroundColor(1, 1, 1),
     _pointRenderer(),
     _pixelSelectionTool(this),
-    _pixelRatio(1.0)
+    _mousePressPosition(),
+    _mouseDragged(false),
+    _pixelRatio(1.0),
+    _points(),
+    _pointGridPyramid(),
+    _levelOfDetail(-1),
+    _drawnLevelOfDetail(-1),
+    _cellColors(),
+    _cellColorScalars(),
+    _cellPointSizeScalars(),
+    _cellPointOpacityScalars(),
+    _cellHighlights(),
+    _cellColorsWatcher(),
+    _cellColorScalarsWatcher(),
+    _cellPointSizeScalarsWatcher(),
+    _cellPointOpacityScalarsWatcher(),
+    _cellHighlightsWatcher()
 {
     setContextMenuPolicy(Qt::CustomContextMenu);
     setAcceptDrops(true);
@@ -56,6 +58,97 @@ ScatterplotWidget::ScatterplotWidget() :
             update();
     });
 
+    // Installed after the pixel selection tool installed its own event filter, so this filter sees the mouse events first
+    installEventFilter(this);
+
+    // Point attributes are aggregated per cell on the thread pool, results for a pyramid which is no longer drawn are discarded,
+    // the individual points remain drawn until the aggregates of all point attributes are ready
+    connect(&_cellColorsWatcher, &QFutureWatcher<CellAggregate<Vector3f>>::finished, this, [this]() {
+        auto cellColors = _cellColorsWatcher.future().takeResult();
+
+        if (cellColors.first != _pointGridPyramid || !isAggregatingPoints())
+            return;
+
+        _cellColors = std::move(cellColors.second);
+
+        if (isDrawingCells())
+            _pointRenderer.setColors(_pointGridPyramid->getColors(_cellColors, _levelOfDetail));
+        else if (isCellAggregationComplete())
+            uploadLevelOfDetail();
+
+        update();
+    });
+
+    connect(&_cellColorScalarsWatcher, &QFutureWatcher<CellAggregate<float>>::finished, this, [this]() {
+        auto cellColorScalars = _cellColorScalarsWatcher.future().takeResult();
+
+        if (cellColorScalars.first != _pointGridPyramid || !isAggregatingPoints())
+            return;
+
+        _cellColorScalars = std::move(cellColorScalars.second);
+
+        if (isDrawingCells())
+            _pointRenderer.setColorChannelScalars(_pointGridPyramid->getScalars(_cellColorScalars, _levelOfDetail));
+        else if (isCellAggregationComplete())
+            uploadLevelOfDetail();
+
+        update();
+    });
+
+    connect(&_cellPointSizeScalarsWatcher, &QFutureWatcher<CellAggregate<float>>::finished, this, [this]() {
+        auto cellPointSizeScalars = _cellPointSizeScalarsWatcher.future().takeResult();
+
+        if (cellPointSizeScalars.first != _pointGridPyramid || !isAggregatingPoints())
+            return;
+
+        _cellPointSizeScalars = std::move(cellPointSizeScalars.second);
+
+        if (isDrawingCells())
+            _pointRenderer.setSizeChannelScalars(_pointGridPyramid->getScalars(_cellPointSizeScalars, _levelOfDetail));
+        else if (isCellAggregationComplete())
+            uploadLevelOfDetail();
+
+        update();
+    });
+
+    connect(&_cellPointOpacityScalarsWatcher, &QFutureWatcher<CellAggregate<float>>::finished, this, [this]() {
+        auto cellPointOpacityScalars = _cellPointOpacityScalarsWatcher.future().takeResult();
+
+        if (cellPointOpacityScalars.first != _pointGridPyramid || !isAggregatingPoints())
+            return;
+
+        _cellPointOpacityScalars = std::move(cellPointOpacityScalars.second);
+
+        if (isDrawingCells())
+            _pointRenderer.setOpacityChannelScalars(_pointGridPyramid->getScalars(_cellPointOpacityScalars, _levelOfDetail));
+        else if (isCellAggregationComplete())
+            uploadLevelOfDetail();
+
+        update();
+    });
+
+    connect(&_cellHighlightsWatcher, &QFutureWatcher<CellAggregate<char>>::finished, this, [this]() {
+        auto cellHighlights = _cellHighlightsWatcher.future().takeResult();
+
+        if (cellHighlights.first != _pointGridPyramid || !isAggregatingPoints())
+            return;
+
+        _cellHighlights = std::move(cellHighlights.second);
+
+        if (isDrawingCells()) {
+            std::int32_t numberOfHighlightedCells = 0;
+
+            const auto highlights = _pointGridPyramid->getHighlights(_cellHighlights, _levelOfDetail, numberOfHighlightedCells);
+
+            _pointRenderer.setHighlights(highlights, numberOfHighlightedCells);
+        }
+        else if (isCellAggregationComplete()) {
+            uploadLevelOfDetail();
+        }
+
+        update();
+    });
+
     QSurfaceFormat surfaceFormat;
 
     surfaceFormat.setRenderableType(QSurfaceFormat::OpenGL);
@@ -158,12 +251,18 @@ void ScatterplotWidget::computeDensity()
     update();
 }
 
-// Positions need to be passed as a pointer as we need to store them locally in order
-// to be able to find the subset of data that's part of a selection. If passed
-// by reference then we can upload the data to the GPU, but not store it in the widget.
-void ScatterplotWidget::setData(const std::vector<Vector2f>* points)
+// Positions need to be passed as a shared snapshot as we need to store them locally:
+// the density renderer keeps a pointer to them, so the widget keeps them alive until
+// other positions are set.
+void ScatterplotWidget::setData(const std::shared_ptr<const std::vector<Vector2f>>& points)
+{
+    // Non-finite positions are skipped so that they cannot poison the bounds
+    setData(points, bounds::getFiniteBounds(PositionView(*points)));
+}
+
+void ScatterplotWidget::setData(const std::shared_ptr<const std::vector<Vector2f>>& points, const Bounds& pointsBounds, const std::shared_ptr<const PointGridPyramid>& pointGridPyramid /*= nullptr*/)
 {
-    auto dataBounds = getDataBounds(*points);
+    auto dataBounds = pointsBounds;
 
     dataBounds.ensureMinimumSize(1e-07f, 1e-07f);
     dataBounds.makeSquare();
@@ -175,8 +274,28 @@ void ScatterplotWidget::setData(const std::vector<Vector2f>* points)
     _pointRenderer.setBounds(_dataBounds);
     _densityRenderer.setBounds(_dataBounds);
 
-    _pointRenderer.setData(*points);
-    _densityRenderer.setData(points);
+    const auto wasAggregatingPoints         = isAggregatingPoints();
+    const auto isPointGridPyramidChanged    = pointGridPyramid != _pointGridPyramid;
+
+    // Aggregates of another pyramid do not line up with the cells
+    if (isPointGridPyramidChanged)
+        clearCellAggregates();
+
+    _points             = points;
+    _pointGridPyramid   = pointGridPyramid;
+    _levelOfDetail      = findLevelOfDetail();
+
+    // Draw aggregated cells when many points share a pixel and the aggregates of all point attributes are ready, the density renderer always estimates from the individual points
+    if (isAggregatingPoints() && isCellAggregationComplete()) {
+        uploadLevelOfDetail();
+    }
+    else {
+        _pointRenderer.setData(*points);
+
+        _drawnLevelOfDetail = -1;
+    }
+
+    _densityRenderer.setData(points.get());
 
     switch (_renderMode)
     {
@@ -196,6 +315,112 @@ void ScatterplotWidget::setData(const std::vector<Vector2f>* points)
    // _pointRenderer.setSelectionOutlineColor(Vector3f(1, 0, 0));
 
     update();
+
+    // The point attributes which the renderer holds do not line up with the drawn points or cells anymore
+    if (wasAggregatingPoints != isAggregatingPoints() || (isAggregatingPoints() && isPointGridPyramidChanged))
+        emit aggregationChanged();
+}
+
+Vector2f ScatterplotWidget::getDataPosition(const QPointF& widgetPosition) const
+{
+    const auto size     = static_cast<float>(std::min(width(), height()));
+    const auto offset   = QPointF((width() - size) / 2.0f, (height() - size) / 2.0f);
+
+    return Vector2f(_dataBounds.getLeft() + _dataBounds.getWidth() * (widgetPosition.x() - offset.x()) / size, _dataBounds.getTop() - _dataBounds.getHeight() * (widgetPosition.y() - offset.y()) / size);
+}
+
+std::vector<Vector2f> ScatterplotWidget::getSelectionShape() const
+{
+    std::vector<Vector2f> selectionShape;
+
+    // The pixel selection tool keeps the mouse positions which make up its shape (in widget coordinates)
+    const auto mousePositions = _pixelSelectionTool.getMousePositions();
+
+    if (mousePositions.isEmpty())
+        return selectionShape;
+
+    switch (_pixelSelectionTool.getType())
+    {
+        case PixelSelectionType::Rectangle:
+        {
+            selectionShape.push_back(getDataPosition(mousePositions.first()));
+            selectionShape.push_back(getDataPosition(mousePositions.last()));
+
+            break;
+        }
+
+        case PixelSelectionType::Lasso:
+        case PixelSelectionType::Polygon:
+        {
+            selectionShape.reserve(mousePositions.count());
+
+            for (const auto& mousePosition : mousePositions)
+                selectionShape.push_back(getDataPosition(mousePosition));
+
+            break;
+        }
+
+        default:
+            break;
+    }
+
+    return selectionShape;
+}
+
+bool ScatterplotWidget::isMouseDragged() const
+{
+    return _mouseDragged;
+}
+
+bool ScatterplotWidget::eventFilter(QObject* target, QEvent* event)
+{
+    if (target != this)
+        return QOpenGLWidget::eventFilter(target, event);
+
+    // Report mouse hovers and clicks, so that the point under the cursor can be picked
+    switch (event->type())
+    {
+        case QEvent::MouseMove:
+        {
+            const auto mouseEvent = static_cast<QMouseEvent*>(event);
+
+            if (mouseEvent->buttons() == Qt::NoButton)
+                emit mouseHovered(mouseEvent->position());
+
+            if ((mouseEvent->buttons() & Qt::LeftButton) && (mouseEvent->position() - _mousePressPosition).manhattanLength() > QApplication::startDragDistance())
+                _mouseDragged = true;
+
+            break;
+        }
+
+        case QEvent::MouseButtonPress:
+        {
+            const auto mouseEvent = static_cast<QMouseEvent*>(event);
+
+            if (mouseEvent->button() == Qt::LeftButton) {
+                _mousePressPosition = mouseEvent->position();
+                _mouseDragged       = false;
+            }
+
+            break;
+        }
+
+        case QEvent::MouseButtonRelease:
+        {
+            const auto mouseEvent = static_cast<QMouseEvent*>(event);
+
+            // A release close to the press position is a click rather than a drag
+            if (mouseEvent->button() == Qt::LeftButton && !_mouseDragged && (mouseEvent->position() - _mousePressPosition).manhattanLength() <= QApplication::startDragDistance())
+                emit mouseClicked(mouseEvent->position());
+
+            break;
+        }
+
+        default:
+            break;
+    }
+
+    return QOpenGLWidget::eventFilter(target, event);
 }
 
 QColor ScatterplotWidget::getBackgroundColor()
@@ -210,39 +435,95 @@ void ScatterplotWidget::setBackgroundColor(QColor color)
     update();
 }
 
-void ScatterplotWidget::setHighlights(const std::vector<char>& highlights, const std::int32_t& numSelectedPoints)
+// The point attributes are shared snapshots, so the cell aggregation on the thread pool reads
+// them without copying, the owner replaces rather than modifies a snapshot which is shared.
+// While the aggregates are not ready yet the attributes are set on the drawn points, and drawn
+// cells are replaced by the individual points once the attributes of the points are set.
+void ScatterplotWidget::setHighlights(const std::shared_ptr<const std::vector<char>>& highlights, const std::int32_t& numSelectedPoints)
 {
-    _pointRenderer.setHighlights(highlights, numSelectedPoints);
+    if (isAggregatingPoints()) {
+        _cellHighlightsWatcher.setFuture(QtConcurrent::run([pointGridPyramid = _pointGridPyramid, highlights]() -> CellAggregate<char> {
+            return { pointGridPyramid, pointGridPyramid->aggregateHighlights(*highlights) };
+        }));
+    }
+    else {
+        uploadPoints();
+    }
+
+    if (!isDrawingCells())
+        _pointRenderer.setHighlights(*highlights, numSelectedPoints);
 
     update();
 }
 
-void ScatterplotWidget::setScalars(const std::vector<float>& scalars)
+void ScatterplotWidget::setScalars(const std::shared_ptr<const std::vector<float>>& scalars)
 {
-    _pointRenderer.setColorChannelScalars(scalars);
+    if (isAggregatingPoints()) {
+        _cellColorScalarsWatcher.setFuture(QtConcurrent::run([pointGridPyramid = _pointGridPyramid, scalars]() -> CellAggregate<float> {
+            return { pointGridPyramid, pointGridPyramid->aggregateScalars(*scalars) };
+        }));
+    }
+    else {
+        uploadPoints();
+    }
+
+    if (!isDrawingCells())
+        _pointRenderer.setColorChannelScalars(*scalars);
     
     update();
 }
 
-void ScatterplotWidget::setColors(const std::vector<Vector3f>& colors)
+void ScatterplotWidget::setColors(const std::shared_ptr<const std::vector<Vector3f>>& colors)
 {
-    _pointRenderer.setColors(colors);
+    if (isAggregatingPoints()) {
+        _cellColorsWatcher.setFuture(QtConcurrent::run([pointGridPyramid = _pointGridPyramid, colors]() -> CellAggregate<Vector3f> {
+            return { pointGridPyramid, pointGridPyramid->aggregateColors(*colors) };
+        }));
+    }
+    else {
+        uploadPoints();
+    }
+
+    if (!isDrawingCells())
+        _pointRenderer.setColors(*colors);
+
     _pointRenderer.setScalarEffect(None);
 
     update();
 }
 
-void ScatterplotWidget::setPointSizeScalars(const std::vector<float>& pointSizeScalars)
+void ScatterplotWidget::setPointSizeScalars(const std::shared_ptr<const std::vector<float>>& pointSizeScalars)
 {
-    _pointRenderer.setSizeChannelScalars(pointSizeScalars);
-    _pointRenderer.setPointSize(*std::max_element(pointSizeScalars.begin(), pointSizeScalars.end()));
+    if (isAggregatingPoints()) {
+        _cellPointSizeScalarsWatcher.setFuture(QtConcurrent::run([pointGridPyramid = _pointGridPyramid, pointSizeScalars]() -> CellAggregate<float> {
+            return { pointGridPyramid, pointGridPyramid->aggregateScalars(*pointSizeScalars) };
+        }));
+    }
+    else {
+        uploadPoints();
+    }
+
+    if (!isDrawingCells())
+        _pointRenderer.setSizeChannelScalars(*pointSizeScalars);
+
+    _pointRenderer.setPointSize(*std::max_element(pointSizeScalars->begin(), pointSizeScalars->end()));
 
     update();
 }
 
-void ScatterplotWidget::setPointOpacityScalars(const std::vector<float>& pointOpacityScalars)
+void ScatterplotWidget::setPointOpacityScalars(const std::shared_ptr<const std::vector<float>>& pointOpacityScalars)
 {
-    _pointRenderer.setOpacityChannelScalars(pointOpacityScalars);
+    if (isAggregatingPoints()) {
+        _cellPointOpacityScalarsWatcher.setFuture(QtConcurrent::run([pointGridPyramid = _pointGridPyramid, pointOpacityScalars]() -> CellAggregate<float> {
+            return { pointGridPyramid, pointGridPyramid->aggregateScalars(*pointOpacityScalars) };
+        }));
+    }
+    else {
+        uploadPoints();
+    }
+
+    if (!isDrawingCells())
+        _pointRenderer.setOpacityChannelScalars(*pointOpacityScalars);
 
     update();
 }
@@ -312,6 +593,16 @@ void ScatterplotWidget::showHighlights(bool show)
     update();
 }
 
+bool ScatterplotWidget::isAggregatingPoints() const
+{
+    return _levelOfDetail >= 0;
+}
+
+bool ScatterplotWidget::isDrawingCells() const
+{
+    return _drawnLevelOfDetail >= 0;
+}
+
 void ScatterplotWidget::createScreenshot(std::int32_t width, std::int32_t height, const QString& fileName, const QColor& backgroundColor)
 {
     // Exit if the viewer is not initialized
@@ -529,6 +820,9 @@ void ScatterplotWidget::resizeGL(int w, int h)
     float hDiff = ((hAspect - 1) / 2.0);
 
     toIsotropicCoordinates = Matrix3f(wAspect, 0, 0, hAspect, -wDiff, -hDiff);
+
+    // The size of the cells which are drawn follows the size of the widget
+    updateLevelOfDetail();
 }
 
 void ScatterplotWidget::paintGL()
@@ -600,6 +894,113 @@ void ScatterplotWidget::cleanup()
     _densityRenderer.destroy();
 }
 
+void ScatterplotWidget::updateLevelOfDetail()
+{
+    if (_points == nullptr)
+        return;
+
+    const auto wasAggregatingPoints = isAggregatingPoints();
+    const auto level                = findLevelOfDetail();
+
+    if (level == _levelOfDetail)
+        return;
+
+    _levelOfDetail = level;
+
+    // Drawn cells only switch levels directly, otherwise the drawn representation remains until the point attributes line up with the other one
+    if (isAggregatingPoints()) {
+        if (isDrawingCells() || isCellAggregationComplete())
+            uploadLevelOfDetail();
+    }
+    else if (!isDrawingCells()) {
+        clearCellAggregates();
+    }
+
+    // The point attributes need to be set again for the other representation
+    if (wasAggregatingPoints != isAggregatingPoints())
+        emit aggregationChanged();
+}
+
+std::int32_t ScatterplotWidget::findLevelOfDetail() const
+{
+    if (_points == nullptr || !_pointGridPyramid || !_pointGridPyramid->isValid() || _points->size() != _pointGridPyramid->getNumberOfPoints())
+        return -1;
+
+    const auto gridBounds = _pointGridPyramid->getBounds();
+
+    // The data bounds are mapped to the smallest side of the widget, aim for cells of about one pixel (the grid may extend beyond the data bounds)
+    const auto gridScale    = std::max(gridBounds.getWidth() / _dataBounds.getWidth(), gridBounds.getHeight() / _dataBounds.getHeight());
+    const auto resolution   = static_cast<std::uint32_t>(std::ceil(std::min(_windowSize.width(), _windowSize.height()) * gridScale));
+    const auto level        = _pointGridPyramid->findLevel(resolution);
+
+    // Aggregating only pays off when many points share a cell of the level
+    if (_points->size() < static_cast<std::size_t>(MINIMUM_POINTS_PER_CELL) * _pointGridPyramid->getNumberOfCells(level))
+        return -1;
+
+    return static_cast<std::int32_t>(level);
+}
+
+void ScatterplotWidget::uploadLevelOfDetail()
+{
+    _drawnLevelOfDetail = _levelOfDetail;
+
+    _pointRenderer.setData(_pointGridPyramid->getPositions(_levelOfDetail));
+
+    if (!_cellColors.empty())
+        _pointRenderer.setColors(_pointGridPyramid->getColors(_cellColors, _levelOfDetail));
+
+    if (!_cellColorScalars.empty())
+        _pointRenderer.setColorChannelScalars(_pointGridPyramid->getScalars(_cellColorScalars, _levelOfDetail));
+
+    if (!_cellPointSizeScalars.empty())
+        _pointRenderer.setSizeChannelScalars(_pointGridPyramid->getScalars(_cellPointSizeScalars, _levelOfDetail));
+
+    if (!_cellPointOpacityScalars.empty())
+        _pointRenderer.setOpacityChannelScalars(_pointGridPyramid->getScalars(_cellPointOpacityScalars, _levelOfDetail));
+
+    if (!_cellHighlights.empty()) {
+        std::int32_t numberOfHighlightedCells = 0;
+
+        const auto highlights = _pointGridPyramid->getHighlights(_cellHighlights, _levelOfDetail, numberOfHighlightedCells);
+
+        _pointRenderer.setHighlights(highlights, numberOfHighlightedCells);
+    }
+
+    update();
+}
+
+bool ScatterplotWidget::isCellAggregationComplete() const
+{
+    // Colors and color scalars are not set in every coloring mode, so these are only waited for while they are aggregated
+    if (_cellPointSizeScalars.empty() || _cellPointOpacityScalars.empty() || _cellHighlights.empty())
+        return false;
+
+    return !_cellColorsWatcher.isRunning() && !_cellColorScalarsWatcher.isRunning() && !_cellPointSizeScalarsWatcher.isRunning() && !_cellPointOpacityScalarsWatcher.isRunning() && !_cellHighlightsWatcher.isRunning();
+}
+
+void ScatterplotWidget::uploadPoints()
+{
+    if (!isDrawingCells())
+        return;
+
+    _drawnLevelOfDetail = -1;
+
+    clearCellAggregates();
+
+    _pointRenderer.setData(*_points);
+
+    update();
+}
+
+void ScatterplotWidget::clearCellAggregates()
+{
+    _cellColors.clear();
+    _cellColorScalars.clear();
+    _cellPointSizeScalars.clear();
+    _cellPointOpacityScalars.clear();
+    _cellHighlights.clear();
+}
+
 void ScatterplotWidget::setColorMap(const QImage& colorMapImage)
 {
     _colorMapImage = colorMapImage;
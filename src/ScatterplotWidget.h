@@ -4,6 +4,8 @@
 #include "renderers/DensityRenderer.h"
 #include "util/PixelSelectionTool.h"
 
+#include "PointGridPyramid.h"
+
 #include "graphics/Vector2f.h"
 #include "graphics/Vector3f.h"
 #include "graphics/Matrix3f.h"
@@ -12,10 +14,14 @@
 
 #include <QOpenGLWidget>
 #include <QOpenGLFunctions_3_3_Core>
+#include <QFutureWatcher>
 
 #include <QMouseEvent>
 #include <QMenu>
 
+#include <memory>
+#include <utility>
+
 using namespace mv;
 using namespace mv::gui;
 using namespace mv::util;
@@ -63,33 +69,47 @@ public:
     /**
      * Feed 2-dimensional data to the scatterplot.
      */
-    void setData(const std::vector<Vector2f>* data);
-    void setHighlights(const std::vector<char>& highlights, const std::int32_t& numSelectedPoints);
-    void setScalars(const std::vector<float>& scalars);
+    void setData(const std::shared_ptr<const std::vector<Vector2f>>& data);
+
+    /**
+     * Feed 2-dimensional \p data with precomputed \p dataBounds to the scatterplot
+     * @param data Point positions (the widget keeps the snapshot alive as long as it draws it)
+     * @param dataBounds Bounds of the finite point positions
+     * @param pointGridPyramid Pyramid of \p data, when set the points are drawn as aggregated grid cells when they are dense enough
+     */
+    void setData(const std::shared_ptr<const std::vector<Vector2f>>& data, const Bounds& dataBounds, const std::shared_ptr<const PointGridPyramid>& pointGridPyramid = nullptr);
+    void setHighlights(const std::shared_ptr<const std::vector<char>>& highlights, const std::int32_t& numSelectedPoints);
+    void setScalars(const std::shared_ptr<const std::vector<float>>& scalars);
 
     /**
      * Set colors for each individual data point
-     * @param colors Vector of colors (size must match that of the loaded points dataset)
+     * @param colors Snapshot of the colors (size must match that of the loaded points dataset, it is shared while it is aggregated per cell)
      */
-    void setColors(const std::vector<Vector3f>& colors);
+    void setColors(const std::shared_ptr<const std::vector<Vector3f>>& colors);
 
     /**
      * Set point size scalars
-     * @param pointSizeScalars Point size scalars
+     * @param pointSizeScalars Snapshot of the point size scalars
      */
-    void setPointSizeScalars(const std::vector<float>& pointSizeScalars);
+    void setPointSizeScalars(const std::shared_ptr<const std::vector<float>>& pointSizeScalars);
 
     /**
      * Set point opacity scalars
-     * @param pointOpacityScalars Point opacity scalars (assume the values are normalized)
+     * @param pointOpacityScalars Snapshot of the point opacity scalars (assume the values are normalized)
      */
-    void setPointOpacityScalars(const std::vector<float>& pointOpacityScalars);
+    void setPointOpacityScalars(const std::shared_ptr<const std::vector<float>>& pointOpacityScalars);
 
     void setScalarEffect(PointEffect effect);
     void setPointScaling(mv::gui::PointScaling scalingMode);
 
     void showHighlights(bool show);
 
+    /** Returns true when the point attributes are aggregated per grid cell, so that the cells can be drawn instead of the individual points */
+    bool isAggregatingPoints() const;
+
+    /** Returns true when the point renderer draws aggregated grid cells (only once the aggregates of all point attributes are ready) */
+    bool isDrawingCells() const;
+
     /**
      * Set sigma value for kernel density esitmation.
      * @param sigma kernel width as a fraction of the output square width. Typical values are [0.01 .. 0.5]
@@ -100,6 +120,23 @@ public:
         return _dataBounds;
     }
 
+    /**
+     * Map \p widgetPosition to data space (in the same way the renderers map the data bounds to the widget)
+     * @param widgetPosition Position in widget coordinates
+     * @return Position in data space
+     */
+    Vector2f getDataPosition(const QPointF& widgetPosition) const;
+
+    /**
+     * Get the shape of the current (or last) pixel selection in data space, for
+     * rectangle, lasso and polygon selection types (empty for other types)
+     * @return Shape vertices (the two corners in case of a rectangle)
+     */
+    std::vector<Vector2f> getSelectionShape() const;
+
+    /** Returns true when the mouse moved further than the drag distance since the left mouse button was pressed */
+    bool isMouseDragged() const;
+
     Vector3f getColorMapRange() const;
     void setColorMapRange(const float& min, const float& max);
 
@@ -185,11 +222,41 @@ public: // Selection
      */
     void setSelectionOutlineHaloEnabled(bool selectionOutlineHaloEnabled);
 
+protected:
+
+    /**
+     * Reports mouse hovers and clicks
+     * @param target Target object
+     * @param event Event that occurred
+     */
+    bool eventFilter(QObject* target, QEvent* event) override;
+
 protected:
     void initializeGL()         Q_DECL_OVERRIDE;
     void resizeGL(int w, int h) Q_DECL_OVERRIDE;
     void paintGL()              Q_DECL_OVERRIDE;
     void cleanup();
+
+    /** Switch to the pyramid level which matches the size of the widget, the drawn representation remains until the point attributes line up with the other one */
+    void updateLevelOfDetail();
+
+    /**
+     * Find the pyramid level whose cells are about a pixel in size
+     * @return Level (-1 when the individual points should be drawn, e.g. when the cells would hold only a few points each)
+     */
+    std::int32_t findLevelOfDetail() const;
+
+    /** Upload the positions of the pyramid level along with the aggregated point attributes */
+    void uploadLevelOfDetail();
+
+    /** Returns whether the aggregates of all point attributes are ready, so that the cells can be drawn without point attributes which do not line up */
+    bool isCellAggregationComplete() const;
+
+    /** Replace the drawn cells by the individual points, when the point attributes are set for the points again */
+    void uploadPoints();
+
+    /** Release the point attributes which are aggregated per cell */
+    void clearCellAggregates();
     
 public: // Const access to renderers
 
@@ -221,12 +288,27 @@ signals:
      */
     void coloringModeChanged(const ColoringMode& coloringMode);
 
+    /**
+     * Signals that the mouse moved over the widget without any button pressed
+     * @param widgetPosition Mouse position in widget coordinates
+     */
+    void mouseHovered(const QPointF& widgetPosition);
+
+    /**
+     * Signals that the left mouse button was clicked (pressed and released without dragging)
+     * @param widgetPosition Mouse position in widget coordinates
+     */
+    void mouseClicked(const QPointF& widgetPosition);
+
     /** Signals that the density computation has started */
     void densityComputationStarted();
 
     /** Signals that the density computation has ended */
     void densityComputationEnded();
 
+    /** Signals that the points switched between being drawn individually and as aggregated grid cells (or between pyramids), the point attributes need to be set again */
+    void aggregationChanged();
+
 public slots:
     void computeDensity();
     
@@ -234,6 +316,11 @@ private slots:
     void updatePixelRatio();
 
 private:
+
+    /** Point attribute aggregated per finest occupied cell, along with the pyramid it was aggregated for */
+    template<typename T>
+    using CellAggregate = std::pair<std::shared_ptr<const PointGridPyramid>, std::vector<T>>;
+
     const Matrix3f          toClipCoordinates = Matrix3f(2, 0, 0, 2, -1, -1);
     Matrix3f                toNormalisedCoordinates;
     Matrix3f                toIsotropicCoordinates;
@@ -247,5 +334,23 @@ private:
     Bounds                  _dataBounds;                        /** Bounds of the loaded data */
     QImage                  _colorMapImage;
     PixelSelectionTool      _pixelSelectionTool;
+    QPointF                 _mousePressPosition;                /** Position of the last left mouse button press (widget coordinates) */
+    bool                    _mouseDragged;                      /** Whether the mouse moved further than the drag distance since the last left mouse button press */
     float                   _pixelRatio;
+    std::shared_ptr<const std::vector<Vector2f>> _points;                       /** Point positions which were set last (the density renderer references them) */
+    std::shared_ptr<const PointGridPyramid>     _pointGridPyramid;              /** Aggregates the points of very large point sets per grid cell (built by the plugin) */
+    std::int32_t                                _levelOfDetail;                 /** Pyramid level whose cells should be drawn (-1 when the individual points should be drawn) */
+    std::int32_t                                _drawnLevelOfDetail;            /** Pyramid level whose cells the point renderer holds (-1 when it holds the individual points) */
+    std::vector<Vector3f>                       _cellColors;                    /** Mean point color per finest occupied cell */
+    std::vector<float>                          _cellColorScalars;              /** Maximum color scalar per finest occupied cell */
+    std::vector<float>                          _cellPointSizeScalars;          /** Maximum point size scalar per finest occupied cell */
+    std::vector<float>                          _cellPointOpacityScalars;       /** Maximum point opacity scalar per finest occupied cell */
+    std::vector<char>                           _cellHighlights;                /** Highlight per finest occupied cell */
+    QFutureWatcher<CellAggregate<Vector3f>>     _cellColorsWatcher;             /** Watches the in-flight aggregation of the point colors */
+    QFutureWatcher<CellAggregate<float>>        _cellColorScalarsWatcher;       /** Watches the in-flight aggregation of the color scalars */
+    QFutureWatcher<CellAggregate<float>>        _cellPointSizeScalarsWatcher;   /** Watches the in-flight aggregation of the point size scalars */
+    QFutureWatcher<CellAggregate<float>>        _cellPointOpacityScalarsWatcher;/** Watches the in-flight aggregation of the point opacity scalars */
+    QFutureWatcher<CellAggregate<char>>         _cellHighlightsWatcher;         /** Watches the in-flight aggregation of the highlights */
+
+    static constexpr std::uint32_t  MINIMUM_POINTS_PER_CELL     = 4;            /** Average number of points per drawn cell below which the individual points are drawn */
 };
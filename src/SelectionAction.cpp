@@ -16,7 +16,11 @@ SelectionAction::SelectionAction(QObject* parent, const QString& title) :
     _outlineOverrideColorAction(this, "Custom color", true),
     _outlineScaleAction(this, "Scale", 100.0f, 500.0f, 200.0f, 1),
     _outlineOpacityAction(this, "Opacity", 0.0f, 100.0f, 100.0f, 1),
-    _outlineHaloEnabledAction(this, "Halo")
+    _outlineHaloEnabledAction(this, "Halo"),
+    _exactSelectionAction(this, "Exact selection"),
+    _updateIntervalAction(this, "Update interval", 0, 250, 16),
+    _clickSelectionAction(this, "Click select"),
+    _clickRadiusAction(this, "Click radius", 0, 100, 0)
 {
     setIcon(mv::Application::getIconFont("FontAwesome").getIcon("mouse-pointer"));
     setConfigurationFlag(WidgetAction::ConfigurationFlag::ForceCollapsedInGroup);
@@ -27,6 +31,10 @@ SelectionAction::SelectionAction(QObject* parent, const QString& title) :
     addAction(&_pixelSelectionAction.getSelectAction());
     addAction(&_pixelSelectionAction.getNotifyDuringSelectionAction());
     addAction(&_pixelSelectionAction.getOverlayColorAction());
+    addAction(&_exactSelectionAction);
+    addAction(&_updateIntervalAction);
+    addAction(&_clickSelectionAction);
+    addAction(&_clickRadiusAction);
 
     addAction(&getDisplayModeAction());
     addAction(&getOutlineScaleAction());
@@ -36,6 +44,14 @@ SelectionAction::SelectionAction(QObject* parent, const QString& title) :
     _pixelSelectionAction.getOverlayColorAction().setText("Color");
 
     _displayModeAction.setToolTip("The way in which selection is visualized");
+    _exactSelectionAction.setToolTip("Test points against the rectangle, lasso or polygon shape in data space instead of against the rasterized selection area");
+
+    _updateIntervalAction.setToolTip("Minimum time between selection updates while selecting, intermediate updates are coalesced");
+    _updateIntervalAction.setSuffix("ms");
+
+    _clickSelectionAction.setToolTip("Select the point under the cursor with a single click (rectangle, brush and lasso selection)");
+    _clickRadiusAction.setToolTip("Select all points within this screen distance of the click, the nearest point only when zero");
+    _clickRadiusAction.setSuffix("px");
 
     _outlineScaleAction.setSuffix("%");
     _outlineOpacityAction.setSuffix("%");
@@ -46,12 +62,15 @@ SelectionAction::SelectionAction(QObject* parent, const QString& title) :
         _outlineScaleAction.setEnabled(isOutline);
         _outlineOpacityAction.setEnabled(isOutline);
         _outlineHaloEnabledAction.setEnabled(isOutline);
+
+        _clickRadiusAction.setEnabled(_clickSelectionAction.isChecked());
     };
 
     updateActionsReadOnly();
 
     connect(&_displayModeAction, &OptionAction::currentIndexChanged, this, updateActionsReadOnly);
     connect(&_outlineOverrideColorAction, &ToggleAction::toggled, this, updateActionsReadOnly);
+    connect(&_clickSelectionAction, &ToggleAction::toggled, this, updateActionsReadOnly);
 }
 
 void SelectionAction::initialize(ScatterplotPlugin* scatterplotPlugin)
@@ -140,6 +159,10 @@ void SelectionAction::connectToPublicAction(WidgetAction* publicAction, bool rec
         actions().connectPrivateActionToPublicAction(&_outlineScaleAction, &publicSelectionAction->getOutlineScaleAction(), recursive);
         actions().connectPrivateActionToPublicAction(&_outlineOpacityAction, &publicSelectionAction->getOutlineOpacityAction(), recursive);
         actions().connectPrivateActionToPublicAction(&_outlineHaloEnabledAction, &publicSelectionAction->getOutlineHaloEnabledAction(), recursive);
+        actions().connectPrivateActionToPublicAction(&_exactSelectionAction, &publicSelectionAction->getExactSelectionAction(), recursive);
+        actions().connectPrivateActionToPublicAction(&_updateIntervalAction, &publicSelectionAction->getUpdateIntervalAction(), recursive);
+        actions().connectPrivateActionToPublicAction(&_clickSelectionAction, &publicSelectionAction->getClickSelectionAction(), recursive);
+        actions().connectPrivateActionToPublicAction(&_clickRadiusAction, &publicSelectionAction->getClickRadiusAction(), recursive);
     }
 
     GroupAction::connectToPublicAction(publicAction, recursive);
@@ -157,6 +180,10 @@ void SelectionAction::disconnectFromPublicAction(bool recursive)
         actions().disconnectPrivateActionFromPublicAction(&_outlineScaleAction, recursive);
         actions().disconnectPrivateActionFromPublicAction(&_outlineOpacityAction, recursive);
         actions().disconnectPrivateActionFromPublicAction(&_outlineHaloEnabledAction, recursive);
+        actions().disconnectPrivateActionFromPublicAction(&_exactSelectionAction, recursive);
+        actions().disconnectPrivateActionFromPublicAction(&_updateIntervalAction, recursive);
+        actions().disconnectPrivateActionFromPublicAction(&_clickSelectionAction, recursive);
+        actions().disconnectPrivateActionFromPublicAction(&_clickRadiusAction, recursive);
     }
 
     GroupAction::disconnectFromPublicAction(recursive);
@@ -172,6 +199,10 @@ void SelectionAction::fromVariantMap(const QVariantMap& variantMap)
     _outlineScaleAction.fromParentVariantMap(variantMap);
     _outlineOpacityAction.fromParentVariantMap(variantMap);
     _outlineHaloEnabledAction.fromParentVariantMap(variantMap);
+    _exactSelectionAction.fromParentVariantMap(variantMap);
+    _updateIntervalAction.fromParentVariantMap(variantMap);
+    _clickSelectionAction.fromParentVariantMap(variantMap);
+    _clickRadiusAction.fromParentVariantMap(variantMap);
 }
 
 QVariantMap SelectionAction::toVariantMap() const
@@ -184,6 +215,10 @@ QVariantMap SelectionAction::toVariantMap() const
     _outlineScaleAction.insertIntoVariantMap(variantMap);
     _outlineOpacityAction.insertIntoVariantMap(variantMap);
     _outlineHaloEnabledAction.insertIntoVariantMap(variantMap);
+    _exactSelectionAction.insertIntoVariantMap(variantMap);
+    _updateIntervalAction.insertIntoVariantMap(variantMap);
+    _clickSelectionAction.insertIntoVariantMap(variantMap);
+    _clickRadiusAction.insertIntoVariantMap(variantMap);
 
     return variantMap;
 }
\ No newline at end of file
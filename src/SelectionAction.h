@@ -2,6 +2,7 @@
 
 #include <actions/GroupAction.h>
 #include <actions/PixelSelectionAction.h>
+#include <actions/IntegralAction.h>
 
 class ScatterplotPlugin;
 
@@ -63,6 +64,10 @@ public: // Action getters
     DecimalAction& getOutlineScaleAction() { return _outlineScaleAction; }
     DecimalAction& getOutlineOpacityAction() { return _outlineOpacityAction; }
     ToggleAction& getOutlineHaloEnabledAction() { return _outlineHaloEnabledAction; }
+    ToggleAction& getExactSelectionAction() { return _exactSelectionAction; }
+    IntegralAction& getUpdateIntervalAction() { return _updateIntervalAction; }
+    ToggleAction& getClickSelectionAction() { return _clickSelectionAction; }
+    IntegralAction& getClickRadiusAction() { return _clickRadiusAction; }
 
 private:
     PixelSelectionAction    _pixelSelectionAction;          /** Pixel selection action */
@@ -71,6 +76,10 @@ private:
     DecimalAction           _outlineScaleAction;            /** Selection outline scale action */
     DecimalAction           _outlineOpacityAction;          /** Selection outline opacity action */
     ToggleAction            _outlineHaloEnabledAction;      /** Selection outline halo enabled action */
+    ToggleAction            _exactSelectionAction;          /** Select with the exact selection shape in data space instead of the rasterized selection area */
+    IntegralAction          _updateIntervalAction;          /** Minimum time between selection updates while selecting (frame budget) */
+    ToggleAction            _clickSelectionAction;          /** Select the point(s) under the cursor with a single click */
+    IntegralAction          _clickRadiusAction;             /** Screen space radius of click selection in pixels (zero selects the nearest point only) */
 
     friend class mv::AbstractActionsManager;
 };
@@ -0,0 +1,41 @@
+#include "SelectionBitset.h"
+
+SelectionBitset::SelectionBitset() :
+    _numberOfPoints(0),
+    _numberOfSelectedPoints(0),
+    _words()
+{
+}
+
+void SelectionBitset::reset(std::uint32_t numberOfPoints)
+{
+    _numberOfPoints         = numberOfPoints;
+    _numberOfSelectedPoints = 0;
+
+    _words.assign((static_cast<std::size_t>(numberOfPoints) + 63) / 64, 0);
+}
+
+void SelectionBitset::assign(std::uint32_t numberOfPoints, const std::vector<std::uint32_t>& localIndices)
+{
+    reset(numberOfPoints);
+
+    for (const auto& localIndex : localIndices)
+        if (localIndex < _numberOfPoints)
+            _words[localIndex >> 6] |= std::uint64_t(1) << (localIndex & 63);
+
+    // Count afterwards, so that duplicate indices are only counted once
+    for (const auto& word : _words)
+        _numberOfSelectedPoints += qPopulationCount(word);
+}
+
+std::uint32_t SelectionBitset::getNumberOfDifferences(const SelectionBitset& other) const
+{
+    Q_ASSERT(_numberOfPoints == other._numberOfPoints);
+
+    std::uint32_t numberOfDifferences = 0;
+
+    for (std::size_t wordIndex = 0; wordIndex < _words.size(); wordIndex++)
+        numberOfDifferences += qPopulationCount(_words[wordIndex] ^ other._words[wordIndex]);
+
+    return numberOfDifferences;
+}
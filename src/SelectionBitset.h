@@ -0,0 +1,103 @@
+#pragma once
+
+#include <QtAlgorithms>
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * Selection bitset class
+ *
+ * Word-packed selection state of the points in a dataset (one bit per local point
+ * index). The number of set bits is cached, so that consumers can query the
+ * selection size without counting and visit only the selected points by skipping
+ * empty words.
+ */
+class SelectionBitset
+{
+public:
+
+    /** Default constructor */
+    SelectionBitset();
+
+    /**
+     * Reset to \p numberOfPoints unselected points
+     * @param numberOfPoints Number of points
+     */
+    void reset(std::uint32_t numberOfPoints);
+
+    /**
+     * Reset to \p numberOfPoints points of which \p localIndices are selected
+     * @param numberOfPoints Number of points
+     * @param localIndices Local indices of the selected points (out of range indices are ignored)
+     */
+    void assign(std::uint32_t numberOfPoints, const std::vector<std::uint32_t>& localIndices);
+
+    /** Get the number of points */
+    std::uint32_t getNumberOfPoints() const {
+        return _numberOfPoints;
+    }
+
+    /** Get the number of selected points */
+    std::uint32_t getNumberOfSelectedPoints() const {
+        return _numberOfSelectedPoints;
+    }
+
+    /**
+     * Establish whether the point at \p localIndex is selected
+     * @param localIndex Local point index (must be smaller than the number of points)
+     * @return Boolean determining whether the point is selected
+     */
+    bool isSelected(std::uint32_t localIndex) const {
+        return (_words[localIndex >> 6] >> (localIndex & 63)) & 1u;
+    }
+
+    /**
+     * Invoke \p visitor with the local index of each selected point, in ascending order
+     * @param visitor Callable which takes the local point index
+     */
+    template<typename Visitor>
+    void forEachSelected(Visitor visitor) const {
+        for (std::size_t wordIndex = 0; wordIndex < _words.size(); wordIndex++) {
+            auto word = _words[wordIndex];
+
+            while (word != 0) {
+                visitor(static_cast<std::uint32_t>((wordIndex << 6) + qCountTrailingZeroBits(word)));
+
+                word &= word - 1;
+            }
+        }
+    }
+
+    /**
+     * Get the number of points whose selection state differs from \p other (which must have the same number of points)
+     * @param other Other selection bitset
+     * @return Number of points which differ
+     */
+    std::uint32_t getNumberOfDifferences(const SelectionBitset& other) const;
+
+    /**
+     * Invoke \p visitor with the local index and selection state (in this bitset) of each point which differs from \p other, in ascending order
+     * @param other Other selection bitset (must have the same number of points)
+     * @param visitor Callable which takes the local point index and whether the point is selected
+     */
+    template<typename Visitor>
+    void forEachDifference(const SelectionBitset& other, Visitor visitor) const {
+        for (std::size_t wordIndex = 0; wordIndex < _words.size(); wordIndex++) {
+            auto word = _words[wordIndex] ^ other._words[wordIndex];
+
+            while (word != 0) {
+                const auto bitIndex = qCountTrailingZeroBits(word);
+
+                visitor(static_cast<std::uint32_t>((wordIndex << 6) + bitIndex), ((_words[wordIndex] >> bitIndex) & 1u) != 0);
+
+                word &= word - 1;
+            }
+        }
+    }
+
+private:
+    std::uint32_t               _numberOfPoints;            /** Number of points */
+    std::uint32_t               _numberOfSelectedPoints;    /** Cached number of set bits */
+    std::vector<std::uint64_t>  _words;                     /** Packed selection bits */
+};
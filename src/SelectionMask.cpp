@@ -0,0 +1,127 @@
+#include "SelectionMask.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+SelectionMask::SelectionMask(const QImage& selectionAreaImage, const Bounds& dataBounds) :
+    _width(selectionAreaImage.width()),
+    _height(selectionAreaImage.height()),
+    _pixels(1 + static_cast<std::size_t>(_width) * _height, 0),
+    _summedArea(static_cast<std::size_t>(_width + 1) * (_height + 1), 0),
+    _boundingRect(),
+    _offsetU(0),
+    _offsetV(0),
+    _originX(dataBounds.getLeft()),
+    _originY(dataBounds.getTop()),
+    _scaleU(0.0f),
+    _scaleV(0.0f)
+{
+    const auto size = std::min(_width, _height);
+
+    _offsetU    = (_width - size) / 2;
+    _offsetV    = (_height - size) / 2;
+    _scaleU     = size / dataBounds.getWidth();
+    _scaleV     = size / dataBounds.getHeight();
+
+    // Convert once, so that the pixels can be read directly from the scan lines
+    const auto alphaImage = selectionAreaImage.convertToFormat(QImage::Format_Alpha8);
+
+    int left = _width, right = -1, top = _height, bottom = -1;
+
+    for (int v = 0; v < _height; v++) {
+        const auto scanLine = alphaImage.constScanLine(v);
+        const auto row      = _pixels.data() + 1 + static_cast<std::size_t>(v) * _width;
+
+        std::uint32_t rowSum = 0;
+
+        for (int u = 0; u < _width; u++) {
+            row[u] = scanLine[u] > 0 ? 1 : 0;
+
+            rowSum += row[u];
+
+            _summedArea[getSummedAreaIndex(u + 1, v + 1)] = _summedArea[getSummedAreaIndex(u + 1, v)] + rowSum;
+        }
+
+        if (rowSum == 0)
+            continue;
+
+        const auto first    = std::find(row, row + _width, 1);
+        const auto last     = std::find(std::make_reverse_iterator(row + _width), std::make_reverse_iterator(row), 1);
+
+        left    = std::min(left, static_cast<int>(first - row));
+        right   = std::max(right, static_cast<int>(last.base() - row) - 1);
+        top     = std::min(top, v);
+        bottom  = std::max(bottom, v);
+    }
+
+    if (right >= left)
+        _boundingRect = QRect(QPoint(left, top), QPoint(right, bottom));
+}
+
+bool SelectionMask::isCompatible(const SelectionMask& other) const
+{
+    return _width == other._width && _height == other._height && _originX == other._originX && _originY == other._originY && _scaleU == other._scaleU && _scaleV == other._scaleV;
+}
+
+QRect SelectionMask::getDifferenceRect(const SelectionMask& other) const
+{
+    Q_ASSERT(isCompatible(other));
+
+    int left = _width, right = -1, top = _height, bottom = -1;
+
+    for (int v = 0; v < _height; v++) {
+        const auto row      = getRow(v);
+        const auto otherRow = other.getRow(v);
+
+        if (std::memcmp(row, otherRow, _width) == 0)
+            continue;
+
+        const auto first    = std::mismatch(row, row + _width, otherRow).first;
+        const auto last     = std::mismatch(std::make_reverse_iterator(row + _width), std::make_reverse_iterator(row), std::make_reverse_iterator(otherRow + _width)).first;
+
+        left    = std::min(left, static_cast<int>(first - row));
+        right   = std::max(right, static_cast<int>(last.base() - row) - 1);
+        top     = std::min(top, v);
+        bottom  = std::max(bottom, v);
+    }
+
+    if (right < left)
+        return QRect();
+
+    return QRect(QPoint(left, top), QPoint(right, bottom));
+}
+
+std::uint32_t SelectionMask::getNumberOfSelectedPixels(const QRect& rect) const
+{
+    const auto clipped = rect.intersected(QRect(0, 0, _width, _height));
+
+    if (clipped.isEmpty())
+        return 0;
+
+    const auto x0 = clipped.left(), x1 = clipped.right() + 1;
+    const auto y0 = clipped.top(), y1 = clipped.bottom() + 1;
+
+    return _summedArea[getSummedAreaIndex(x1, y1)] - _summedArea[getSummedAreaIndex(x0, y1)] - _summedArea[getSummedAreaIndex(x1, y0)] + _summedArea[getSummedAreaIndex(x0, y0)];
+}
+
+QRect SelectionMask::getPixelRect(const Bounds& bounds) const
+{
+    return QRect(getPixel(bounds.getLeft(), bounds.getTop()), getPixel(bounds.getRight(), bounds.getBottom()));
+}
+
+Bounds SelectionMask::getBounds(const QRect& rect) const
+{
+    // Grow by one pixel on each side to stay conservative under floating point round-off
+    const auto topLeft      = getPosition(rect.left() - 1, rect.top() - 1);
+    const auto bottomRight  = getPosition(rect.right() + 2, rect.bottom() + 2);
+
+    Bounds bounds;
+
+    bounds.setLeft(topLeft.x);
+    bounds.setRight(bottomRight.x);
+    bounds.setBottom(bottomRight.y);
+    bounds.setTop(topLeft.y);
+
+    return bounds;
+}
@@ -0,0 +1,152 @@
+#pragma once
+
+#include "graphics/Vector2f.h"
+#include "graphics/Bounds.h"
+
+#include <QImage>
+#include <QPoint>
+#include <QRect>
+
+#include <cstdint>
+#include <vector>
+
+using namespace mv;
+
+/**
+ * Selection mask class
+ *
+ * Converts the selection area image of the pixel selection tool once into a packed
+ * 8-bit mask (one byte per pixel, 1 when selected) with direct row access. Lookups
+ * are free of bounds checks and format conversions, which makes them suitable for
+ * per-point hit testing. The mask also maps data space positions to mask pixels in
+ * the same way the scatter plot widget lays out the (square) data bounds.
+ */
+class SelectionMask
+{
+public:
+
+    /**
+     * Construct from \p selectionAreaImage and \p dataBounds
+     * @param selectionAreaImage Selection area image (pixels with non-zero alpha are selected)
+     * @param dataBounds Bounds of the data as displayed in the scatter plot widget
+     */
+    SelectionMask(const QImage& selectionAreaImage, const Bounds& dataBounds);
+
+    /** Get the width of the mask in pixels */
+    int getWidth() const {
+        return _width;
+    }
+
+    /** Get the height of the mask in pixels */
+    int getHeight() const {
+        return _height;
+    }
+
+    /** Get the bounding rectangle of the selected pixels (empty when nothing is selected) */
+    QRect getBoundingRect() const {
+        return _boundingRect;
+    }
+
+    /** Get pointer to the first pixel of row \p v (\p v must be inside the mask) */
+    const std::uint8_t* getRow(int v) const {
+        return _pixels.data() + 1 + static_cast<std::size_t>(v) * _width;
+    }
+
+    /**
+     * Establish whether pixel \p u, \p v is selected (pixels outside the mask are not)
+     * @param u Pixel column
+     * @param v Pixel row
+     * @return Boolean determining whether the pixel is selected
+     */
+    bool contains(int u, int v) const {
+        // The unsigned comparisons fold the lower and upper bound checks, out of bound lookups are redirected to the zero guard byte
+        const auto inside = static_cast<std::size_t>((static_cast<unsigned>(u) < static_cast<unsigned>(_width)) & (static_cast<unsigned>(v) < static_cast<unsigned>(_height)));
+
+        return _pixels[inside * (1 + static_cast<std::size_t>(v) * _width + u)] != 0;
+    }
+
+    /**
+     * Map data space position \p x, \p y to a mask pixel
+     * @param x Data space x-coordinate
+     * @param y Data space y-coordinate
+     * @return Pixel in the mask
+     */
+    QPoint getPixel(float x, float y) const {
+        return QPoint(_offsetU + static_cast<int>((x - _originX) * _scaleU), _offsetV + static_cast<int>((_originY - y) * _scaleV));
+    }
+
+    /**
+     * Map mask pixel \p u, \p v back to a data space position
+     * @param u Pixel column
+     * @param v Pixel row
+     * @return Data space position of the top-left corner of the pixel
+     */
+    Vector2f getPosition(int u, int v) const {
+        return Vector2f(_originX + (u - _offsetU) / _scaleU, _originY - (v - _offsetV) / _scaleV);
+    }
+
+    /**
+     * Establish whether data space position \p x, \p y lies in a selected pixel
+     * @param x Data space x-coordinate
+     * @param y Data space y-coordinate
+     * @return Boolean determining whether the position is selected
+     */
+    bool containsPosition(float x, float y) const {
+        return contains(_offsetU + static_cast<int>((x - _originX) * _scaleU), _offsetV + static_cast<int>((_originY - y) * _scaleV));
+    }
+
+    /**
+     * Establish whether \p other has the same size and maps data space to pixels in the same way
+     * @param other Other selection mask
+     * @return Boolean determining whether the masks can be compared pixel by pixel
+     */
+    bool isCompatible(const SelectionMask& other) const;
+
+    /**
+     * Get the bounding rectangle of the pixels which differ from \p other (which must be compatible)
+     * @param other Other selection mask
+     * @return Bounding rectangle of the changed pixels (empty when the masks are equal)
+     */
+    QRect getDifferenceRect(const SelectionMask& other) const;
+
+    /**
+     * Get the number of selected pixels in \p rect in constant time (using a summed area table)
+     * @param rect Rectangle in pixels (clipped to the mask)
+     * @return Number of selected pixels
+     */
+    std::uint32_t getNumberOfSelectedPixels(const QRect& rect) const;
+
+    /**
+     * Get the pixel rectangle which contains all data space positions in \p bounds
+     * @param bounds Data space bounds
+     * @return Pixel rectangle (not clipped to the mask)
+     */
+    QRect getPixelRect(const Bounds& bounds) const;
+
+    /**
+     * Get the data space bounds which contain all pixels in \p rect
+     * @param rect Pixel rectangle
+     * @return Data space bounds
+     */
+    Bounds getBounds(const QRect& rect) const;
+
+private:
+
+    /** Get index of \p x, \p y in the summed area table */
+    std::size_t getSummedAreaIndex(int x, int y) const {
+        return static_cast<std::size_t>(y) * (_width + 1) + x;
+    }
+
+private:
+    int                                 _width;             /** Width of the mask in pixels */
+    int                                 _height;            /** Height of the mask in pixels */
+    std::vector<std::uint8_t>           _pixels;            /** Leading zero guard byte followed by the packed mask pixels */
+    std::vector<std::uint32_t>          _summedArea;        /** Summed area table with a leading zero row and column */
+    QRect                               _boundingRect;      /** Bounding rectangle of the selected pixels */
+    int                                 _offsetU;           /** Horizontal pixel offset of the (square) data area */
+    int                                 _offsetV;           /** Vertical pixel offset of the (square) data area */
+    float                               _originX;           /** Data space x-coordinate of the left edge */
+    float                               _originY;           /** Data space y-coordinate of the top edge */
+    float                               _scaleU;            /** Pixels per data space unit along the x-axis */
+    float                               _scaleV;            /** Pixels per data space unit along the y-axis */
+};
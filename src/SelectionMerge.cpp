@@ -0,0 +1,42 @@
+#include "SelectionMerge.h"
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+
+namespace selection {
+
+void makeSorted(std::vector<std::uint32_t>& indices)
+{
+    // Strictly increasing indices are sorted and duplicate free already
+    if (std::adjacent_find(indices.begin(), indices.end(), std::greater_equal<std::uint32_t>()) == indices.end())
+        return;
+
+    std::sort(indices.begin(), indices.end());
+
+    indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+}
+
+std::vector<std::uint32_t> unite(const std::vector<std::uint32_t>& first, const std::vector<std::uint32_t>& second)
+{
+    std::vector<std::uint32_t> united;
+
+    united.reserve(first.size() + second.size());
+
+    std::set_union(first.begin(), first.end(), second.begin(), second.end(), std::back_inserter(united));
+
+    return united;
+}
+
+std::vector<std::uint32_t> subtract(const std::vector<std::uint32_t>& first, const std::vector<std::uint32_t>& second)
+{
+    std::vector<std::uint32_t> difference;
+
+    difference.reserve(first.size());
+
+    std::set_difference(first.begin(), first.end(), second.begin(), second.end(), std::back_inserter(difference));
+
+    return difference;
+}
+
+}
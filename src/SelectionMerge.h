@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * Selection merge helpers
+ *
+ * Combine selections which are stored as sorted, duplicate free vectors of point
+ * indices. Union and difference walk both inputs once, so merging a selection of
+ * n indices with m target indices takes O(n + m) time without any hashing.
+ */
+namespace selection {
+
+/**
+ * Sort \p indices in ascending order and remove duplicates (no-op when they already are)
+ * @param indices Point indices
+ */
+void makeSorted(std::vector<std::uint32_t>& indices);
+
+/**
+ * Get the union of sorted \p first and sorted \p second
+ * @param first Sorted point indices
+ * @param second Sorted point indices
+ * @return Sorted point indices which are in \p first or in \p second
+ */
+std::vector<std::uint32_t> unite(const std::vector<std::uint32_t>& first, const std::vector<std::uint32_t>& second);
+
+/**
+ * Get the difference of sorted \p first and sorted \p second
+ * @param first Sorted point indices
+ * @param second Sorted point indices
+ * @return Sorted point indices which are in \p first but not in \p second
+ */
+std::vector<std::uint32_t> subtract(const std::vector<std::uint32_t>& first, const std::vector<std::uint32_t>& second);
+
+}
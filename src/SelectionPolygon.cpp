@@ -0,0 +1,98 @@
+#include "SelectionPolygon.h"
+
+#include <algorithm>
+#include <limits>
+
+SelectionPolygon::SelectionPolygon(const std::vector<Vector2f>& vertices, bool isRectangle) :
+    _isRectangle(isRectangle),
+    _bounds(),
+    _edges()
+{
+    _bounds.setLeft(std::numeric_limits<float>::max());
+    _bounds.setRight(std::numeric_limits<float>::lowest());
+    _bounds.setBottom(std::numeric_limits<float>::max());
+    _bounds.setTop(std::numeric_limits<float>::lowest());
+
+    for (const auto& vertex : vertices) {
+        _bounds.setLeft(std::min(_bounds.getLeft(), vertex.x));
+        _bounds.setRight(std::max(_bounds.getRight(), vertex.x));
+        _bounds.setBottom(std::min(_bounds.getBottom(), vertex.y));
+        _bounds.setTop(std::max(_bounds.getTop(), vertex.y));
+    }
+
+    if (_isRectangle || vertices.size() < 3)
+        return;
+
+    _edges.reserve(vertices.size());
+
+    for (std::size_t vertexIndex = 0; vertexIndex < vertices.size(); vertexIndex++) {
+        const auto& first   = vertices[vertexIndex];
+        const auto& second  = vertices[(vertexIndex + 1) % vertices.size()];
+        const auto deltaY   = second.y - first.y;
+
+        _edges.push_back({ first.x, first.y, second.y, deltaY != 0.0f ? (second.x - first.x) / deltaY : 0.0f });
+    }
+}
+
+bool SelectionPolygon::isValid() const
+{
+    if (_bounds.getWidth() <= 0.0f || _bounds.getHeight() <= 0.0f)
+        return false;
+
+    return _isRectangle || !_edges.empty();
+}
+
+const Bounds& SelectionPolygon::getBounds() const
+{
+    return _bounds;
+}
+
+bool SelectionPolygon::containsBounds(const Bounds& bounds) const
+{
+    if (!_isRectangle)
+        return false;
+
+    return bounds.getLeft() >= _bounds.getLeft() && bounds.getRight() <= _bounds.getRight() && bounds.getBottom() >= _bounds.getBottom() && bounds.getTop() <= _bounds.getTop();
+}
+
+void SelectionPolygon::contains(const PositionView& positions, const std::uint32_t* begin, const std::uint32_t* end, std::uint8_t* hits) const
+{
+    float           x[BATCH_SIZE];
+    float           y[BATCH_SIZE];
+    std::uint8_t    inside[BATCH_SIZE];
+
+    const auto left     = _bounds.getLeft();
+    const auto right    = _bounds.getRight();
+    const auto bottom   = _bounds.getBottom();
+    const auto top      = _bounds.getTop();
+
+    for (auto batchBegin = begin; batchBegin < end; batchBegin += BATCH_SIZE) {
+        const auto batchCount = static_cast<std::uint32_t>(std::min<std::ptrdiff_t>(BATCH_SIZE, end - batchBegin));
+
+        // Gather the batch (a partial batch repeats its last point)
+        for (std::uint32_t lane = 0; lane < BATCH_SIZE; lane++) {
+            const auto localIndex = batchBegin[std::min(lane, batchCount - 1)];
+
+            x[lane] = positions.getX(localIndex);
+            y[lane] = positions.getY(localIndex);
+        }
+
+        if (_isRectangle) {
+            for (std::uint32_t lane = 0; lane < BATCH_SIZE; lane++)
+                inside[lane] = (x[lane] >= left) & (x[lane] <= right) & (y[lane] >= bottom) & (y[lane] <= top);
+        }
+        else {
+
+            // Even-odd rule: count the crossings of a horizontal ray towards positive x
+            for (std::uint32_t lane = 0; lane < BATCH_SIZE; lane++)
+                inside[lane] = 0;
+
+            for (const auto& edge : _edges)
+                for (std::uint32_t lane = 0; lane < BATCH_SIZE; lane++)
+                    inside[lane] ^= ((edge.y0 > y[lane]) != (edge.y1 > y[lane])) & (x[lane] < edge.x0 + (y[lane] - edge.y0) * edge.slope);
+        }
+
+        for (std::uint32_t lane = 0; lane < batchCount; lane++)
+            hits[batchBegin[lane]] = inside[lane];
+    }
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "PositionView.h"
+
+#include "graphics/Vector2f.h"
+#include "graphics/Bounds.h"
+
+#include <cstdint>
+#include <vector>
+
+using namespace mv;
+
+/**
+ * Selection polygon class
+ *
+ * Selection shape (rectangle, lasso or polygon) in data space, which tests points
+ * exactly instead of through the rasterized selection area. Points are processed in
+ * fixed size batches with branch-free inner loops, so that the compiler can map the
+ * lanes of a batch onto SIMD registers.
+ */
+class SelectionPolygon
+{
+public:
+
+    /**
+     * Construct from \p vertices in data space
+     * @param vertices Polygon vertices (for a rectangle only the bounds of the vertices are used)
+     * @param isRectangle Whether the polygon is an axis aligned rectangle
+     */
+    SelectionPolygon(const std::vector<Vector2f>& vertices, bool isRectangle);
+
+    /** Returns true when the polygon encloses an area */
+    bool isValid() const;
+
+    /** Get the bounds of the polygon */
+    const Bounds& getBounds() const;
+
+    /**
+     * Establish whether \p bounds lie completely inside the polygon (only decided for rectangles, always false for other polygons)
+     * @param bounds Bounds in data space
+     * @return Boolean determining whether the bounds are inside
+     */
+    bool containsBounds(const Bounds& bounds) const;
+
+    /**
+     * Test the points referenced by the local indices in [\p begin, \p end) and store the outcome per point in \p hits
+     * @param positions Point positions
+     * @param begin Pointer to the first local point index
+     * @param end Pointer past the last local point index
+     * @param hits Hit flag per local point index (output)
+     */
+    void contains(const PositionView& positions, const std::uint32_t* begin, const std::uint32_t* end, std::uint8_t* hits) const;
+
+protected:
+
+    /** Polygon edge, prepared for the crossing number test */
+    struct Edge {
+        float   x0;         /** X-coordinate of the first vertex */
+        float   y0;         /** Y-coordinate of the first vertex */
+        float   y1;         /** Y-coordinate of the second vertex */
+        float   slope;      /** Change in x per unit y (zero for horizontal edges, which never cross) */
+    };
+
+private:
+    bool                _isRectangle;   /** Whether the polygon is an axis aligned rectangle */
+    Bounds              _bounds;        /** Bounds of the polygon */
+    std::vector<Edge>   _edges;         /** Edges of the (closed) polygon */
+
+    static constexpr std::uint32_t BATCH_SIZE = 8;     /** Number of points which are tested together */
+};
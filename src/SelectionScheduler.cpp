@@ -0,0 +1,98 @@
+#include "SelectionScheduler.h"
+
+#include <algorithm>
+
+SelectionScheduler::SelectionScheduler(QObject* parent /*= nullptr*/) :
+    QObject(parent),
+    _interval(0),
+    _timer(),
+    _elapsedTimer(),
+    _pending(false),
+    _numberOfCoalescedUpdates(0),
+    _numberOfDroppedUpdates(0)
+{
+    _timer.setSingleShot(true);
+
+    connect(&_timer, &QTimer::timeout, this, &SelectionScheduler::trigger);
+}
+
+std::int32_t SelectionScheduler::getInterval() const
+{
+    return _interval;
+}
+
+void SelectionScheduler::setInterval(std::int32_t interval)
+{
+    _interval = std::max(0, interval);
+}
+
+void SelectionScheduler::schedule()
+{
+    if (_pending) {
+        _numberOfCoalescedUpdates++;
+        return;
+    }
+
+    const auto elapsed = _elapsedTimer.isValid() ? _elapsedTimer.elapsed() : static_cast<qint64>(_interval);
+
+    if (elapsed >= _interval) {
+        trigger();
+        return;
+    }
+
+    _pending = true;
+
+    _timer.start(static_cast<int>(_interval - elapsed));
+}
+
+void SelectionScheduler::flush()
+{
+    if (!_pending)
+        return;
+
+    _timer.stop();
+
+    trigger();
+}
+
+void SelectionScheduler::cancel()
+{
+    if (!_pending)
+        return;
+
+    _timer.stop();
+
+    _pending = false;
+
+    _numberOfDroppedUpdates++;
+}
+
+bool SelectionScheduler::isPending() const
+{
+    return _pending;
+}
+
+std::uint32_t SelectionScheduler::getNumberOfCoalescedUpdates() const
+{
+    return _numberOfCoalescedUpdates;
+}
+
+std::uint32_t SelectionScheduler::getNumberOfDroppedUpdates() const
+{
+    return _numberOfDroppedUpdates;
+}
+
+void SelectionScheduler::resetStatistics()
+{
+    _numberOfCoalescedUpdates   = 0;
+    _numberOfDroppedUpdates     = 0;
+}
+
+void SelectionScheduler::trigger()
+{
+    _pending = false;
+
+    _elapsedTimer.restart();
+
+    emit triggered();
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+
+#include <cstdint>
+
+/**
+ * Selection scheduler class
+ *
+ * Rate limits selection updates while the user is selecting. Requests which arrive
+ * within the frame budget of the previous update are coalesced into one trailing
+ * update, so that at most one update is triggered per interval. Pending updates can
+ * be flushed (e.g. when the selection ends, so that the final state is always
+ * delivered) or cancelled (e.g. when the data changes).
+ */
+class SelectionScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    /**
+     * Construct with \p parent object
+     * @param parent Pointer to parent object
+     */
+    SelectionScheduler(QObject* parent = nullptr);
+
+    /** Get the minimum time between two updates in milliseconds */
+    std::int32_t getInterval() const;
+
+    /**
+     * Set the minimum time between two updates to \p interval
+     * @param interval Interval in milliseconds (zero triggers each request immediately)
+     */
+    void setInterval(std::int32_t interval);
+
+    /** Request an update, it is triggered immediately when the frame budget allows, otherwise at the end of the interval */
+    void schedule();
+
+    /** Trigger the pending update (if any) immediately */
+    void flush();
+
+    /** Discard the pending update (if any) */
+    void cancel();
+
+    /** Returns true when an update is pending */
+    bool isPending() const;
+
+    /** Get the number of requests which were merged into an already pending update */
+    std::uint32_t getNumberOfCoalescedUpdates() const;
+
+    /** Get the number of pending updates which were discarded */
+    std::uint32_t getNumberOfDroppedUpdates() const;
+
+    /** Reset the coalesced and dropped update counters */
+    void resetStatistics();
+
+private:
+
+    /** Trigger an update */
+    void trigger();
+
+signals:
+
+    /** Signals that an update should be performed */
+    void triggered();
+
+private:
+    std::int32_t    _interval;                      /** Minimum time between two updates in milliseconds */
+    QTimer          _timer;                         /** Timer for the trailing update */
+    QElapsedTimer   _elapsedTimer;                  /** Time since the previous update */
+    bool            _pending;                       /** Whether an update is pending */
+    std::uint32_t   _numberOfCoalescedUpdates;      /** Number of requests merged into a pending update */
+    std::uint32_t   _numberOfDroppedUpdates;        /** Number of discarded pending updates */
+};